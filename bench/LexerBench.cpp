@@ -0,0 +1,104 @@
+/*
+ * Throughput of the lexer in MB/s on a generated MAVN program.
+ *
+ * Only the lexer is linked, so the driver builds against any revision with the
+ * readInputFile/initialize/Do interface, e.g. to compare with the std::map FSM:
+ *	g++ -std=c++14 -O2 -I src bench/LexerBench.cpp src/LexicalAnalysis.cpp src/FiniteStateMachine.cpp
+ *		src/Token.cpp src/NameTable.cpp src/MappedFile.cpp -o lexer_bench
+ *	./lexer_bench [megabytes] [runs]
+ * (NameTable.cpp and MappedFile.cpp only exist since the zero-copy tokens.)
+ */
+
+#include "LexicalAnalysis.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+static const char* INPUT_FILE = "lexer_bench.mavn";
+
+// Generiše program od približno date veličine: deklaracije i mešavina svih vrsta instrukcija
+static string generate(size_t bytes)
+{
+	const int regs = 300;
+	string program;
+	program.reserve(bytes + 256);
+	program += "_mem m1 6;\n";
+	for (int i = 1; i <= regs; i++)
+		program += "_reg r" + to_string(i) + ";\n";
+	program += "_func main;\n";
+
+	unsigned int seed = 12345;
+	auto reg = [&seed, regs]()
+	{
+		seed = seed * 1103515245 + 12345;
+		return "r" + to_string((seed >> 16) % regs + 1);
+	};
+	for (int line = 0; program.size() < bytes; line++)
+	{
+		switch (line % 8)
+		{
+		case 0: program += "lab" + to_string(line) + ":\n\tla\t\t" + reg() + ", m1;\n"; break;
+		case 1: program += "\tlw\t\t" + reg() + ", 0(" + reg() + ");\n"; break;
+		case 2: program += "\tli\t\t" + reg() + ", " + to_string(line % 1000) + ";\n"; break;
+		case 3: program += "\tadd\t\t" + reg() + ", " + reg() + ", " + reg() + ";\n"; break;
+		case 4: program += "\taddi\t" + reg() + ", " + reg() + ", " + to_string(line % 100) + ";\n"; break;
+		case 5: program += "\tsub\t\t" + reg() + ", " + reg() + ", " + reg() + ";\n"; break;
+		case 6: program += "\tsw\t\t" + reg() + ", 4(" + reg() + ");\n"; break;
+		case 7: program += "\tbltz\t" + reg() + ", lab" + to_string(line - 7) + ";\n"; break;
+		}
+	}
+	return program;
+}
+
+int main(int argc, char* argv[])
+{
+	double megabytes = argc > 1 ? atof(argv[1]) : 10.0;
+	int runs = argc > 2 ? atoi(argv[2]) : 5;
+	if (megabytes <= 0 || runs <= 0)
+	{
+		cerr << "Usage: " << argv[0] << " [megabytes] [runs]" << endl;
+		return 1;
+	}
+
+	string program = generate((size_t)(megabytes * 1024 * 1024));
+	{
+		ofstream out(INPUT_FILE, ios_base::binary);
+		out << program;
+	}
+
+	double best = 0;
+	for (int run = 0; run < runs; run++)
+	{
+		LexicalAnalysis lex;
+		if (!lex.readInputFile(INPUT_FILE))
+		{
+			cerr << "Failed to read " << INPUT_FILE << endl;
+			return 1;
+		}
+		lex.initialize();
+
+		chrono::steady_clock::time_point start = chrono::steady_clock::now();
+		bool ok = lex.Do();
+		double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		if (!ok)
+		{
+			cerr << "Lexical analysis failed" << endl;
+			return 1;
+		}
+
+		double throughput = program.size() / (1024.0 * 1024.0) / seconds;
+		cout << "run " << run + 1 << ": " << seconds * 1000 << " ms, " << throughput << " MB/s" << endl;
+		if (throughput > best)
+			best = throughput;
+	}
+	cout << "input " << program.size() / (1024.0 * 1024.0) << " MB, best " << best << " MB/s" << endl;
+
+	remove(INPUT_FILE);
+	return 0;
+}
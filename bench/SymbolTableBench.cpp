@@ -0,0 +1,115 @@
+/*
+ * Scaling of syntax analysis with the number of symbols.
+ *
+ * For every size N a program with N register variables, N instructions and a label every
+ * 64 instructions is parsed. Every instruction looks up its operands and every declaration
+ * checks for duplicates, so with constant time symbol lookups the time per instruction stays
+ * flat as N grows (a linear scan of the symbols would grow it N times).
+ *	g++ -std=c++14 -O2 -I src bench/SymbolTableBench.cpp $(ls src/*.cpp | grep -v 'main.cpp\|CountingAllocator.cpp')
+ *		-o symbol_bench
+ *	./symbol_bench [N ...]          (default 1000 10000 100000)
+ */
+
+#include "SyntaxAnalysis.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const char* INPUT_FILE = "symbol_bench.mavn";
+
+// Generiše program sa n registarskih promenljivih i n instrukcija nad nasumičnim registrima
+static string generate(int n)
+{
+	string program = "_mem m1 6;\n";
+	for (int i = 1; i <= n; i++)
+		program += "_reg r" + to_string(i) + ";\n";
+	program += "_func main;\n";
+
+	unsigned int seed = 12345;
+	auto reg = [&seed, n]()
+	{
+		seed = seed * 1103515245 + 12345;
+		return "r" + to_string((seed >> 8) % n + 1);
+	};
+	for (int i = 0; i < n; i++)
+	{
+		if (i % 64 == 0)
+			program += "lab" + to_string(i / 64) + ":\n";
+		if (i % 64 == 63)
+			program += "\tbltz\t" + reg() + ", lab" + to_string(i / 64) + ";\n";
+		else
+			program += "\tadd\t\t" + reg() + ", " + reg() + ", " + reg() + ";\n";
+	}
+	return program;
+}
+
+// Meri trajanje sintaksne analize programa sa n simbola, u milisekundama
+static double parse(int n)
+{
+	{
+		ofstream out(INPUT_FILE, ios_base::binary);
+		out << generate(n);
+	}
+
+	LexicalAnalysis lex;
+	if (!lex.readInputFile(INPUT_FILE))
+		throw runtime_error("Failed to read the generated program");
+	lex.initialize();
+	if (!lex.Do())
+		throw runtime_error("Lexical analysis failed");
+
+	CompilationContext context;
+	SyntaxAnalysis syntax(lex, context);
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+	bool ok = syntax.Do();
+	double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+	if (!ok)
+		throw runtime_error("Syntax analysis failed");
+	return ms;
+}
+
+int main(int argc, char* argv[])
+{
+	vector<int> sizes;
+	for (int i = 1; i < argc; i++)
+		sizes.push_back(atoi(argv[i]));
+	if (sizes.empty())
+		sizes = { 1000, 10000, 100000 };
+
+	try
+	{
+		double previous = 0;
+		printf("%10s %12s %14s %10s\n", "symbols", "parse ms", "ns / instr", "growth");
+		for (int n : sizes)
+		{
+			if (n <= 0)
+			{
+				cerr << "Usage: " << argv[0] << " [N ...]" << endl;
+				return 1;
+			}
+			double ms = parse(n);
+			printf("%10d %12.2f %14.1f", n, ms, ms * 1e6 / n);
+			if (previous > 0)
+				printf(" %9.1fx", ms / previous);
+			printf("\n");
+			previous = ms;
+		}
+	}
+	catch (runtime_error e)
+	{
+		cerr << e.what() << endl;
+		remove(INPUT_FILE);
+		return 1;
+	}
+
+	remove(INPUT_FILE);
+	return 0;
+}
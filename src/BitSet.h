@@ -0,0 +1,138 @@
+#ifndef __BIT_SET__
+#define __BIT_SET__
+
+#include <vector>
+#include <utility>
+
+
+/**
+ * Dense set of small non negative integers (variable positions) stored as a bit vector.
+ * Union, difference and comparison work a whole 64 bit word at a time.
+ */
+class BitSet
+{
+public:
+	BitSet() : m_size(0) {}
+	explicit BitSet(int size) : m_words((size + 63) / 64, 0), m_size(size) {}
+
+	/**
+	 * Changes the number of elements the set can hold and empties it
+	 */
+	void resize(int size)
+	{
+		m_words.assign((size + 63) / 64, 0);
+		m_size = size;
+	}
+
+	/**
+	 * Returns the number of elements the set can hold
+	 */
+	int size() const { return m_size; }
+
+	void set(int i) { m_words[i >> 6] |= 1ULL << (i & 63); }
+	void reset(int i) { m_words[i >> 6] &= ~(1ULL << (i & 63)); }
+	bool test(int i) const { return (m_words[i >> 6] >> (i & 63) & 1) != 0; }
+
+	/**
+	 * Removes all elements
+	 */
+	void clear()
+	{
+		for (unsigned long long& w : m_words)
+			w = 0;
+	}
+
+	/**
+	 * Returns true if there are no elements in the set
+	 */
+	bool empty() const
+	{
+		for (unsigned long long w : m_words)
+			if (w != 0)
+				return false;
+		return true;
+	}
+
+	/**
+	 * Adds all elements of the other set (both sets must have the same size)
+	 */
+	void unionWith(const BitSet& other)
+	{
+		for (unsigned int i = 0; i < m_words.size(); ++i)
+			m_words[i] |= other.m_words[i];
+	}
+
+	/**
+	 * Removes all elements of the other set (both sets must have the same size)
+	 */
+	void subtract(const BitSet& other)
+	{
+		for (unsigned int i = 0; i < m_words.size(); ++i)
+			m_words[i] &= ~other.m_words[i];
+	}
+
+	/**
+	 * Returns the smallest element greater or equal to from, or -1 if there is none
+	 */
+	int findNext(int from) const
+	{
+		if (from >= m_size)
+			return -1;
+		unsigned int w = from >> 6;
+		unsigned long long word = m_words[w] & (~0ULL << (from & 63));
+		while (true)
+		{
+			if (word != 0)
+				return (int)(w * 64 + countTrailingZeros(word));
+			if (++w >= m_words.size())
+				return -1;
+			word = m_words[w];
+		}
+	}
+
+	/**
+	 * Returns the number of elements in the set
+	 */
+	int count() const
+	{
+		int n = 0;
+		for (unsigned long long w : m_words)
+			for (; w != 0; w &= w - 1)
+				++n;
+		return n;
+	}
+
+	/**
+	 * Exchanges contents with the other set without copying
+	 */
+	void swap(BitSet& other)
+	{
+		m_words.swap(other.m_words);
+		std::swap(m_size, other.m_size);
+	}
+
+	bool operator==(const BitSet& other) const { return m_words == other.m_words; }
+	bool operator!=(const BitSet& other) const { return m_words != other.m_words; }
+
+private:
+	static int countTrailingZeros(unsigned long long word)
+	{
+		int n = 0;
+		while ((word & 0xffff) == 0)
+		{
+			word >>= 16;
+			n += 16;
+		}
+		while ((word & 1) == 0)
+		{
+			word >>= 1;
+			++n;
+		}
+		return n;
+	}
+
+	std::vector<unsigned long long> m_words;
+	int m_size;
+};
+
+#endif
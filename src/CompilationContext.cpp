@@ -0,0 +1,70 @@
+#include "CompilationContext.h"
+
+CompilationContext::CompilationContext() : nextVariable(0), nextInstruction(0)
+{
+}
+
+// Kreira promenljivu, registarska promenljiva dobija sledeću poziciju
+Variable* CompilationContext::newVariable(Variable::VariableType type, const std::string& name, int value)
+{
+	Variable* var = arena.newVariable(type, name, value);
+	if (type == Variable::REG_VAR)
+		var->setPos(nextVariable++);
+	return var;
+}
+
+// Kreira instrukciju sa sledećom pozicijom
+Instruction* CompilationContext::newInstruction(InstructionType type, Variable* label)
+{
+	Instruction* in = arena.newInstruction(type, label);
+	in->setPos(nextInstruction++);
+	return in;
+}
+
+// Vraća listu instrukcija
+Instructions& CompilationContext::getInstructions()
+{
+	return instrs;
+}
+
+// Vraća listu registarskih promenljivih
+Variables& CompilationContext::getRegs()
+{
+	return reg_vars;
+}
+
+// Vraća listu memorijskih promenljivih
+Variables& CompilationContext::getMem()
+{
+	return mem_vars;
+}
+
+// Vraća listu labela
+Variables& CompilationContext::getLabels()
+{
+	return label_vars;
+}
+
+// Vraća listu konstanti
+Variables& CompilationContext::getConsts()
+{
+	return const_vars;
+}
+
+// Vraća tabelu simbola
+SymbolTable& CompilationContext::getSymbols()
+{
+	return symbols;
+}
+
+// Vraća podešavanja ispisa
+Dump& CompilationContext::getDump()
+{
+	return dump;
+}
+
+// Vraća izveštaj o trajanju faza
+TimeReport& CompilationContext::getTimeReport()
+{
+	return report;
+}
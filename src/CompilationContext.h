@@ -0,0 +1,67 @@
+#ifndef __COMPILATION_CONTEXT__
+#define __COMPILATION_CONTEXT__
+
+#include <string>
+
+#include "IR.h"
+#include "IRArena.h"
+#include "SymbolTable.h"
+#include "Dump.h"
+#include "TimeReport.h"
+
+
+/**
+ * State of one compilation: the IR objects and their lists, the symbol table, numbering of
+ * register variables and instructions, dump settings and the time report.
+ *
+ * The analyses keep a reference to the context instead of using process-wide state, so any
+ * number of programs can be compiled one after another or side by side in one process, each
+ * with its own context. The context must outlive the analyses which use it.
+ */
+class CompilationContext
+{
+public:
+	CompilationContext();
+
+	/**
+	 * Creates a variable owned by the context, a register variable gets the next position
+	 * [in] type  - kind of the variable
+	 * [in] name  - name of the variable
+	 * [in] value - value of a constant, offset of a memory variable or 1 for a generated label
+	 */
+	Variable* newVariable(Variable::VariableType type, const std::string& name, int value = 0);
+	/**
+	 * Creates an instruction owned by the context with the next position
+	 * [in] type  - type of the instruction
+	 * [in] label - label of a function (only for I_NO_TYPE)
+	 */
+	Instruction* newInstruction(InstructionType type, Variable* label = nullptr);
+
+	Instructions& getInstructions();
+	Variables& getRegs();
+	Variables& getMem();
+	Variables& getLabels();
+	Variables& getConsts();
+	SymbolTable& getSymbols();
+
+	Dump& getDump();
+	TimeReport& getTimeReport();
+
+private:
+	CompilationContext(const CompilationContext&);
+	CompilationContext& operator=(const CompilationContext&);
+
+	IRArena arena;              // Vlasnik svih promenljivih i instrukcija
+	int nextVariable;           // Pozicija sledeće registarske promenljive
+	int nextInstruction;        // Pozicija sledeće instrukcije
+	Instructions instrs;        // Lista instrukcija
+	Variables reg_vars;         // Lista registarskih promenljivih
+	Variables mem_vars;         // Lista promenljivih za memorijske adrese
+	Variables label_vars;       // Lista oznaka
+	Variables const_vars;       // Lista promenljivih koje drže konstantne vrednosti
+	SymbolTable symbols;        // Heš tabela svih promenljivih, labela i konstanti
+	Dump dump;                  // Podešavanja ispisa
+	TimeReport report;          // Merenje trajanja faza
+};
+
+#endif
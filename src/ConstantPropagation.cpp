@@ -0,0 +1,358 @@
+#include "ConstantPropagation.h"
+#include "Dump.h"
+
+#include <algorithm>
+#include <deque>
+
+// Proverava da li konstanta staje u 16-bitni neposredni operand
+static bool fitsImmediate(int value)
+{
+	return value >= -32768 && value <= 32767;
+}
+
+ConstantPropagation::ConstantPropagation(SyntaxAnalysis& syntax, ControlFlowGraph& cfg, int numVars) :
+	syntax(syntax), instrs(syntax.getInstructions()), cfg(cfg), numVars(numVars)
+{
+}
+
+// Računa vrednosti promenljivih do fiksne tačke i prepisuje kod
+bool ConstantPropagation::Do()
+{
+	std::vector<BasicBlock*>& blocks = cfg.getBlocks();
+	if (blocks.empty())
+		return false;
+
+	Value varying = { VARYING, 0 };
+	blockIn.assign(blocks.size(), Constants());
+	executable.assign(blocks.size(), false);
+	current.assign(numVars, varying);
+	isTouched.assign(numVars, false);
+	touched.clear();
+
+	// vrednosti registara na ulazu u funkciju nisu poznate (nijedna konstanta)
+	BasicBlock* entry = cfg.getEntry();
+	executable[entry->getId()] = true;
+
+	std::deque<BasicBlock*> worklist(1, entry);
+	std::vector<bool> queued(blocks.size(), false);
+	queued[entry->getId()] = true;
+
+	while (!worklist.empty())
+	{
+		BasicBlock* b = worklist.front();
+		worklist.pop_front();
+		queued[b->getId()] = false;
+
+		load(blockIn[b->getId()]);
+		for (Instruction* in : b->getInstructions())
+			transfer(in);
+
+		// izvršive grane bloka
+		Instruction* last = b->getInstructions().back();
+		BasicBlock* fallThrough = last->getType() != I_B && b->getId() + 1 < (int)blocks.size() ?
+			blocks[b->getId() + 1] : nullptr;
+		BasicBlock* target = isBranch(last->getType()) ? cfg.getBlockWithLabel(last->getSrc().back()) : nullptr;
+
+		BasicBlock* next[2] = { fallThrough, target };
+		if (isBranch(last->getType()))
+		{
+			int taken = branchTaken(last);
+			if (taken == 1)
+				next[0] = nullptr;
+			else if (taken == 0)
+				next[1] = nullptr;
+		}
+		Constants values = unload();
+
+		for (BasicBlock* s : next)
+		{
+			if (s == nullptr)
+				continue;
+			bool changed;
+			if (!executable[s->getId()])
+			{
+				// prva izvršiva grana: na ulazu u blok su konstante sa kraja prethodnika
+				blockIn[s->getId()] = values;
+				executable[s->getId()] = true;
+				changed = true;
+			}
+			else
+				changed = meet(blockIn[s->getId()], values);
+			if (changed)
+			{
+				if (!queued[s->getId()])
+				{
+					queued[s->getId()] = true;
+					worklist.push_back(s);
+				}
+			}
+		}
+	}
+
+	return rewrite();
+}
+
+// Presek vrednosti u mreži: c ^ c = c, inače promenljivo (ostaju konstante jednake u oba skupa)
+bool ConstantPropagation::meet(Constants& into, const Constants& from)
+{
+	unsigned int kept = 0;
+	Constants::const_iterator f = from.begin();
+	for (unsigned int i = 0; i < into.size(); i++)
+	{
+		while (f != from.end() && f->first < into[i].first)
+			++f;
+		if (f != from.end() && *f == into[i])
+			into[kept++] = into[i];
+	}
+	bool changed = kept != into.size();
+	into.resize(kept);
+	return changed;
+}
+
+// Učitava konstante u tekuće vrednosti
+void ConstantPropagation::load(const Constants& constants)
+{
+	for (const std::pair<int, int>& c : constants)
+	{
+		current[c.first].state = CONSTANT;
+		current[c.first].constant = c.second;
+		touch(c.first);
+	}
+}
+
+// Vraća konstante iz tekućih vrednosti i vraća tekuće vrednosti na promenljivo
+ConstantPropagation::Constants ConstantPropagation::unload()
+{
+	Constants constants;
+	for (int pos : touched)
+	{
+		if (current[pos].state == CONSTANT)
+			constants.push_back(std::make_pair(pos, current[pos].constant));
+		current[pos].state = VARYING;
+		isTouched[pos] = false;
+	}
+	touched.clear();
+	std::sort(constants.begin(), constants.end());
+	return constants;
+}
+
+// Pamti poziciju čija se tekuća vrednost čita i vraća na promenljivo pri pražnjenju
+void ConstantPropagation::touch(int pos)
+{
+	if (!isTouched[pos])
+	{
+		isTouched[pos] = true;
+		touched.push_back(pos);
+	}
+}
+
+// Vraća tekuću vrednost operanda
+ConstantPropagation::Value ConstantPropagation::valueOf(Variable* var) const
+{
+	if (var->getType() == Variable::CONST_VAR)
+	{
+		Value v = { CONSTANT, var->getValue() };
+		return v;
+	}
+	return current[var->getPos()];
+}
+
+// Računa vrednost koju instrukcija upisuje u odredište (aritmetika je 32-bitna, sa prelivanjem)
+ConstantPropagation::Value ConstantPropagation::evaluate(Instruction* in) const
+{
+	Value result = { VARYING, 0 };
+	Operands& src = in->getSrc();
+
+	switch (in->getType())
+	{
+	case I_LI:
+		return valueOf(src.front());
+	case I_ADD:
+	case I_ADDI:
+	case I_SUB:
+	case I_AND:
+	case I_OR:
+	case I_NOT:
+	{
+		Value a = valueOf(src.front());
+		Value b = valueOf(src.back());
+		if (a.state == VARYING || b.state == VARYING)
+			return result;
+
+		unsigned int x = (unsigned int)a.constant;
+		unsigned int y = (unsigned int)b.constant;
+		unsigned int r = 0;
+		switch (in->getType())
+		{
+		case I_ADD:
+		case I_ADDI:	r = x + y; break;
+		case I_SUB:		r = x - y; break;
+		case I_AND:		r = x & y; break;
+		case I_OR:		r = x | y; break;
+		case I_NOT:		r = ~x; break;
+		default:		break;
+		}
+		result.state = CONSTANT;
+		result.constant = (int)r;
+		return result;
+	}
+	default:
+		// la i lw daju vrednosti koje nisu poznate u vreme prevođenja
+		return result;
+	}
+}
+
+// Određuje da li se skok izvršava: 1 uvek, 0 nikad, -1 nepoznato
+int ConstantPropagation::branchTaken(Instruction* in) const
+{
+	Operands& src = in->getSrc();
+	switch (in->getType())
+	{
+	case I_B:
+		return 1;
+	case I_BLTZ:
+	{
+		Value a = valueOf(src.front());
+		if (a.state == VARYING)
+			return -1;
+		return a.constant < 0 ? 1 : 0;
+	}
+	case I_BNE:
+	{
+		Operands::iterator it = src.begin();
+		Variable* first = *it++;
+		Variable* second = *it;
+		if (first == second)
+			return 0;
+		Value a = valueOf(first);
+		Value b = valueOf(second);
+		if (a.state == VARYING || b.state == VARYING)
+			return -1;
+		return a.constant != b.constant ? 1 : 0;
+	}
+	default:
+		return -1;
+	}
+}
+
+// Primenjuje efekat instrukcije na tekuće vrednosti promenljivih
+void ConstantPropagation::transfer(Instruction* in)
+{
+	for (Variable* d : in->getDst())
+		if (d->getType() == Variable::REG_VAR)
+		{
+			current[d->getPos()] = evaluate(in);
+			touch(d->getPos());
+		}
+}
+
+// Zamenjuje instrukciju novom, nova preuzima labelu
+void ConstantPropagation::replace(Instruction* in, Instruction* with)
+{
+	Instructions::iterator it = positions[in];
+	if (in->getLabel() != nullptr)
+		with->addLabel(in->getLabel());
+	instrs.insert(it, with);
+	instrs.erase(it);
+	positions.erase(in);
+}
+
+// Prepisuje instrukcije izvršivih blokova
+bool ConstantPropagation::rewrite()
+{
+	positions.clear();
+	for (Instructions::iterator it = instrs.begin(); it != instrs.end(); ++it)
+		positions[*it] = it;
+
+	int folded = 0;
+	int branches = 0;
+	for (BasicBlock* b : cfg.getBlocks())
+	{
+		if (!executable[b->getId()])
+			continue;
+
+		load(blockIn[b->getId()]);
+		std::vector<Instruction*> code = b->getInstructions();
+		for (Instruction* in : code)
+		{
+			InstructionType type = in->getType();
+			if (isBranch(type))
+			{
+				if (type == I_B)
+					continue;
+				int taken = branchTaken(in);
+				if (taken == 1)
+				{
+					Instruction* jump = syntax.getContext().newInstruction(I_B);
+					jump->addSrc(in->getSrc().back());
+					replace(in, jump);
+					++branches;
+				}
+				else if (taken == 0 && removeInstruction(instrs, positions[in]))
+				{
+					positions.erase(in);
+					++branches;
+				}
+				continue;
+			}
+
+			if (in->getDst().empty() || in->getDst().front()->getType() != Variable::REG_VAR)
+			{
+				transfer(in);
+				continue;
+			}
+
+			Variable* d = in->getDst().front();
+			Value result = evaluate(in);
+			Instruction* with = nullptr;
+			if (result.state == CONSTANT && type != I_LI)
+			{
+				with = syntax.getContext().newInstruction(I_LI);
+				with->addDst(d);
+				with->addSrc(syntax.constVariable(result.constant));
+			}
+			else if (result.state == VARYING && (type == I_ADD || type == I_SUB))
+			{
+				// jedan operand je konstanta: add/sub postaje addi i registar konstante više nije potreban
+				Variable* a = in->getSrc().front();
+				Variable* c = in->getSrc().back();
+				Value va = valueOf(a);
+				Value vc = valueOf(c);
+				Variable* reg = nullptr;
+				int immediate = 0;
+				if (vc.state == CONSTANT && (type == I_ADD || vc.constant != (int)0x80000000))
+				{
+					reg = a;
+					immediate = type == I_ADD ? vc.constant : -vc.constant;
+				}
+				else if (va.state == CONSTANT && type == I_ADD)
+				{
+					reg = c;
+					immediate = va.constant;
+				}
+				if (reg != nullptr && fitsImmediate(immediate))
+				{
+					with = syntax.getContext().newInstruction(I_ADDI);
+					with->addDst(d);
+					with->addSrc(reg);
+					with->addSrc(syntax.constVariable(immediate));
+				}
+			}
+
+			transfer(in);
+			if (with != nullptr)
+			{
+				replace(in, with);
+				++folded;
+			}
+		}
+		unload();
+	}
+
+	if (folded + branches == 0)
+		return false;
+	Dump& dump = syntax.getContext().getDump();
+	if (dump.enabled(DUMP_PASSES))
+		dump.stream() << "Constant propagation folded " << folded << " instructions and resolved " << branches << " branches" << std::endl;
+	return true;
+}
@@ -0,0 +1,127 @@
+#ifndef __CONSTANT_PROPAGATION__
+#define __CONSTANT_PROPAGATION__
+
+#include "SyntaxAnalysis.h"
+#include "ControlFlowGraph.h"
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+
+/**
+ * Sparse conditional constant propagation over basic blocks.
+ *
+ * At the entry of an executable block a register variable is either a known constant or
+ * varying, a block which isn't executable yet has no values (undefined in the lattice).
+ * Blocks are visited from a worklist, values flow only along edges found to be executable,
+ * and a branch with constant operands makes only one of its edges executable.
+ *
+ * Only the constants reaching a block are stored for it. A visited block is loaded into one
+ * dense array shared by all visits, and only the entries it loaded or defined are read back
+ * and reset, so a visit costs as much as the block and its constants, not the number of
+ * variables.
+ *
+ * After the fixpoint the code is rewritten: instructions computing a constant become li,
+ * add/sub with one constant operand become addi, and constant branches become b or are removed.
+ * Blocks left unreachable are removed by dead code elimination.
+ */
+class ConstantPropagation
+{
+public:
+	/**
+	 * [in] syntax  - owner of the instructions and constants
+	 * [in] cfg     - basic blocks of the instructions
+	 * [in] numVars - number of register variables (positions 0..numVars-1)
+	 */
+	ConstantPropagation(SyntaxAnalysis& syntax, ControlFlowGraph& cfg, int numVars);
+
+	/**
+	 * Runs the propagation and rewrites the code
+	 * [out] return - true if the code was changed
+	 */
+	bool Do();
+
+private:
+	enum State
+	{
+		VARYING,    // Vrednost se menja ili nije poznata u vreme prevođenja
+		CONSTANT    // Uvek ista konstanta
+	};
+
+	struct Value
+	{
+		State state;
+		int constant;
+	};
+
+	/**
+	 * Register variables holding a known constant as (position, constant) pairs sorted by
+	 * position, every variable which isn't in the list is varying
+	 */
+	typedef std::vector<std::pair<int, int>> Constants;
+
+	/**
+	 * Lattice meet of the values (keeps the constants equal in both), returns true if into changed
+	 */
+	static bool meet(Constants& into, const Constants& from);
+
+	/**
+	 * Loads the constants into the current values
+	 */
+	void load(const Constants& constants);
+
+	/**
+	 * Returns the constants among the current values and resets the current values to varying
+	 */
+	Constants unload();
+
+	/**
+	 * Remembers that the current value of the variable at the position has to be read back
+	 */
+	void touch(int pos);
+
+	/**
+	 * Returns the current value of the operand (constants are always CONSTANT)
+	 */
+	Value valueOf(Variable* var) const;
+
+	/**
+	 * Returns the value the instruction writes into its destination
+	 */
+	Value evaluate(Instruction* in) const;
+
+	/**
+	 * Returns 1 if the branch is always taken, 0 if never, -1 if it depends on varying operands
+	 */
+	int branchTaken(Instruction* in) const;
+
+	/**
+	 * Updates the current values with the effect of the instruction
+	 */
+	void transfer(Instruction* in);
+
+	/**
+	 * Replaces the instruction, the replacement takes over its label
+	 */
+	void replace(Instruction* in, Instruction* with);
+
+	/**
+	 * Rewrites instructions of executable blocks using the computed values
+	 * [out] return - true if anything was rewritten
+	 */
+	bool rewrite();
+
+	SyntaxAnalysis& syntax;
+	Instructions& instrs;
+	ControlFlowGraph& cfg;
+	int numVars;
+	std::vector<Constants> blockIn;     // Constants at the entry of every executable block
+	std::vector<Value> current;         // Values inside the visited block, indexed by position
+	std::vector<int> touched;           // Positions loaded or defined in the visited block
+	std::vector<bool> isTouched;        // Position is in touched
+	std::vector<bool> executable;       // Block reached along an executable edge
+	std::unordered_map<Instruction*, Instructions::iterator> positions;
+};
+
+#endif
@@ -18,6 +18,11 @@ const int NUM_STATES = 45;
  */
 const int NUM_OF_CHARACTERS = 47;
 
+/**
+ * Number of distinct input byte values (width of the FSM transition table)
+ */
+const int NUM_OF_BYTES = 256;
+
 /**
  * Use this when instruction interference to other instruction.
  */
@@ -29,15 +34,10 @@ const int __INTERFERENCE__ = 1;
 const int __EMPTY__ = 0;
 
 /**
- * Number of regs in processor.
- */
-const int __REG_NUMBER__ = 4;
-
-/**
- * Use these to print liveness analysis dump.
+ * Interference graphs with at most this many nodes keep a triangular bit matrix
+ * (about 1 MB at the limit), larger graphs keep a hash set of edges.
  */
-const int __DUMPS__ = 1;
-const int __NO_DUMPS__ = 0;
+const int DENSE_INTERFERENCE_LIMIT = 4096;
 
 /**
  * Alignment definitions for nice printing
@@ -0,0 +1,393 @@
+#include "ControlFlowGraph.h"
+
+#include <stdexcept>
+
+// ***********************************************
+// *            BasicBlock methods               *
+// ***********************************************
+
+// Vraća redni broj bloka
+int BasicBlock::getId() const
+{
+	return m_id;
+}
+
+// Vraća instrukcije bloka
+std::vector<Instruction*>& BasicBlock::getInstructions()
+{
+	return m_instructions;
+}
+
+// Vraća sledbenike bloka
+std::vector<BasicBlock*>& BasicBlock::getSucc()
+{
+	return m_succ;
+}
+
+// Vraća prethodnike bloka
+std::vector<BasicBlock*>& BasicBlock::getPred()
+{
+	return m_pred;
+}
+
+// Vraća gen skup bloka
+BitSet& BasicBlock::getUse()
+{
+	return m_use;
+}
+
+// Vraća kill skup bloka
+BitSet& BasicBlock::getDef()
+{
+	return m_def;
+}
+
+// Vraća skup promenljivih živih na ulazu
+BitSet& BasicBlock::getIn()
+{
+	return m_in;
+}
+
+// Vraća skup promenljivih živih na izlazu
+BitSet& BasicBlock::getOut()
+{
+	return m_out;
+}
+
+// Vraća neposrednog dominatora bloka
+BasicBlock* BasicBlock::getIdom() const
+{
+	return m_idom;
+}
+
+// Vraća dubinu ugnežđenosti bloka u petljama
+int BasicBlock::getLoopDepth() const
+{
+	return m_loopDepth;
+}
+
+// ***********************************************
+// *         ControlFlowGraph methods            *
+// ***********************************************
+
+// Proverava da li je instrukcija skok
+bool isBranch(InstructionType type)
+{
+	return type == I_B || type == I_BLTZ || type == I_BNE;
+}
+
+ControlFlowGraph::ControlFlowGraph() : m_blocks(), m_labels()
+{
+}
+
+ControlFlowGraph::~ControlFlowGraph()
+{
+	clear();
+}
+
+// Briše sve blokove
+void ControlFlowGraph::clear()
+{
+	for (BasicBlock* b : m_blocks)
+		delete b;
+	m_blocks.clear();
+	m_labels.clear();
+	m_loops.clear();
+}
+
+// Dodaje granu između dva bloka
+void ControlFlowGraph::link(BasicBlock* from, BasicBlock* to)
+{
+	for (BasicBlock* s : from->getSucc())
+		if (s == to)
+			return;
+	from->getSucc().push_back(to);
+	to->getPred().push_back(from);
+}
+
+// Deli instrukcije na osnovne blokove i povezuje ih
+void ControlFlowGraph::build(Instructions& instrs)
+{
+	clear();
+
+	Variable* function = nullptr;
+	BasicBlock* current = nullptr;
+	for (Instruction* i : instrs)
+	{
+		if (i->isFunc())
+		{
+			function = i->getLabel();
+			continue;
+		}
+
+		// labela ili prethodni skok započinju novi blok
+		if (current == nullptr || i->getLabel() != nullptr)
+		{
+			current = new BasicBlock((int)m_blocks.size());
+			m_blocks.push_back(current);
+			if (i->getLabel() != nullptr)
+				m_labels[i->getLabel()] = current;
+		}
+		current->getInstructions().push_back(i);
+
+		if (isBranch(i->getType()))
+			current = nullptr;
+	}
+
+	// skok na labelu funkcije nastavlja od prve instrukcije funkcije
+	if (function != nullptr && !m_blocks.empty())
+		m_labels[function] = m_blocks.front();
+
+	for (unsigned int k = 0; k < m_blocks.size(); ++k)
+	{
+		BasicBlock* block = m_blocks[k];
+		Instruction* last = block->getInstructions().back();
+
+		if (isBranch(last->getType()))
+		{
+			// labela je uvek poslednji izvorni operand skoka
+			Variable* label = last->getSrc().back();
+			std::unordered_map<Variable*, BasicBlock*>::iterator it = m_labels.find(label);
+			if (it == m_labels.end())
+				throw std::runtime_error("No instruction with " + label->getName() + " exists!");
+			link(block, it->second);
+		}
+
+		if (last->getType() != I_B && k + 1 < m_blocks.size())
+			link(block, m_blocks[k + 1]);
+	}
+}
+
+// Vraća blok koji počinje datom labelom
+BasicBlock* ControlFlowGraph::getBlockWithLabel(Variable* label)
+{
+	std::unordered_map<Variable*, BasicBlock*>::iterator it = m_labels.find(label);
+	return it == m_labels.end() ? nullptr : it->second;
+}
+
+// Računa gen (korišćene pre definisanja) i kill (definisane) skupove blokova
+void ControlFlowGraph::computeLocalSets(int numVars)
+{
+	for (BasicBlock* b : m_blocks)
+	{
+		BitSet& use = b->getUse();
+		BitSet& def = b->getDef();
+		use.resize(numVars);
+		def.resize(numVars);
+		b->getIn().resize(numVars);
+		b->getOut().resize(numVars);
+
+		// unazad kroz blok: use = (use - def_i) U use_i, def = def U def_i
+		std::vector<Instruction*>& code = b->getInstructions();
+		for (std::vector<Instruction*>::reverse_iterator it = code.rbegin(); it != code.rend(); ++it)
+		{
+			for (Variable* v : (*it)->getDef())
+			{
+				use.reset(v->getPos());
+				def.set(v->getPos());
+			}
+			for (Variable* v : (*it)->getUse())
+				use.set(v->getPos());
+		}
+	}
+}
+
+// Vraća sve blokove
+std::vector<BasicBlock*>& ControlFlowGraph::getBlocks()
+{
+	return m_blocks;
+}
+
+// Vraća ulazni blok
+BasicBlock* ControlFlowGraph::getEntry()
+{
+	return m_blocks.empty() ? nullptr : m_blocks.front();
+}
+
+// Vraća blokove u postorderu obilaska u dubinu od ulaznog bloka, nedostižni blokovi su na kraju
+std::vector<BasicBlock*> ControlFlowGraph::postorder()
+{
+	return depthFirstPostorder(m_blocks);
+}
+
+// Obilazak u dubinu od zadatih korena, blokovi se vraćaju u postorderu
+std::vector<BasicBlock*> ControlFlowGraph::depthFirstPostorder(const std::vector<BasicBlock*>& roots)
+{
+	std::vector<BasicBlock*> order;
+	std::vector<bool> visited(m_blocks.size(), false);
+	std::vector<std::pair<BasicBlock*, unsigned int>> stack;
+	order.reserve(m_blocks.size());
+
+	for (BasicBlock* root : roots)
+	{
+		if (visited[root->getId()])
+			continue;
+		visited[root->getId()] = true;
+		stack.push_back(std::make_pair(root, 0u));
+		while (!stack.empty())
+		{
+			BasicBlock* node = stack.back().first;
+			unsigned int& next = stack.back().second;
+			if (next < node->getSucc().size())
+			{
+				BasicBlock* s = node->getSucc()[next++];
+				if (!visited[s->getId()])
+				{
+					visited[s->getId()] = true;
+					stack.push_back(std::make_pair(s, 0u));
+				}
+			}
+			else
+			{
+				order.push_back(node);
+				stack.pop_back();
+			}
+		}
+	}
+	return order;
+}
+
+// Računa dominatore i prirodne petlje
+void ControlFlowGraph::computeLoops()
+{
+	m_loops.clear();
+	for (BasicBlock* b : m_blocks)
+	{
+		b->m_idom = nullptr;
+		b->m_loopDepth = 0;
+	}
+	if (m_blocks.empty())
+		return;
+
+	// dominatori (Cooper, Harvey, Kennedy) nad dostižnim blokovima u obrnutom postorderu
+	BasicBlock* entry = getEntry();
+	std::vector<BasicBlock*> order = depthFirstPostorder(std::vector<BasicBlock*>(1, entry));
+	std::vector<int> postIndex(m_blocks.size(), -1);
+	for (unsigned int k = 0; k < order.size(); ++k)
+		postIndex[order[k]->getId()] = k;
+
+	entry->m_idom = entry;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (std::vector<BasicBlock*>::reverse_iterator it = order.rbegin(); it != order.rend(); ++it)
+		{
+			BasicBlock* b = *it;
+			if (b == entry)
+				continue;
+
+			BasicBlock* newIdom = nullptr;
+			for (BasicBlock* p : b->getPred())
+			{
+				if (p->m_idom == nullptr)
+					continue;
+				if (newIdom == nullptr)
+				{
+					newIdom = p;
+					continue;
+				}
+				BasicBlock* x = p;
+				BasicBlock* y = newIdom;
+				while (x != y)
+				{
+					while (postIndex[x->getId()] < postIndex[y->getId()])
+						x = x->m_idom;
+					while (postIndex[y->getId()] < postIndex[x->getId()])
+						y = y->m_idom;
+				}
+				newIdom = x;
+			}
+			if (b->m_idom != newIdom)
+			{
+				b->m_idom = newIdom;
+				changed = true;
+			}
+		}
+	}
+
+	// povratna grana b -> h postoji kada h dominira nad b; telo petlje su blokovi iz kojih
+	// se stiže do b bez prolaska kroz h
+	for (std::vector<BasicBlock*>::reverse_iterator it = order.rbegin(); it != order.rend(); ++it)
+	{
+		BasicBlock* header = *it;
+		std::vector<BasicBlock*> latches;
+		for (BasicBlock* p : header->getPred())
+			if (dominates(header, p))
+				latches.push_back(p);
+		if (latches.empty())
+			continue;
+
+		Loop loop;
+		loop.header = header;
+		loop.blocks.push_back(header);
+		std::vector<bool> inLoop(m_blocks.size(), false);
+		inLoop[header->getId()] = true;
+		std::vector<BasicBlock*> worklist;
+		for (BasicBlock* l : latches)
+			if (!inLoop[l->getId()])
+			{
+				inLoop[l->getId()] = true;
+				worklist.push_back(l);
+				loop.blocks.push_back(l);
+			}
+		while (!worklist.empty())
+		{
+			BasicBlock* b = worklist.back();
+			worklist.pop_back();
+			for (BasicBlock* p : b->getPred())
+				if (!inLoop[p->getId()] && p->m_idom != nullptr)
+				{
+					inLoop[p->getId()] = true;
+					worklist.push_back(p);
+					loop.blocks.push_back(p);
+				}
+		}
+
+		for (BasicBlock* b : loop.blocks)
+			++b->m_loopDepth;
+		m_loops.push_back(loop);
+	}
+}
+
+// Proverava da li blok a dominira nad blokom b
+bool ControlFlowGraph::dominates(BasicBlock* a, BasicBlock* b) const
+{
+	if (b->m_idom == nullptr)
+		return false;
+	while (true)
+	{
+		if (a == b)
+			return true;
+		if (b->m_idom == b)
+			return false;
+		b = b->m_idom;
+	}
+}
+
+// Vraća prirodne petlje
+std::vector<Loop>& ControlFlowGraph::getLoops()
+{
+	return m_loops;
+}
+
+// Ispisuje blokove i grane između njih
+void ControlFlowGraph::print(std::ostream& out)
+{
+	out << "=---==================---=\n"
+		<< "| Control Flow Graph |\n"
+		<< "=---==================---=\n";
+	for (BasicBlock* b : m_blocks)
+	{
+		out << "B" << b->getId() << ":";
+		for (Instruction* i : b->getInstructions())
+			out << "\n\t" << i->toString();
+		out << "\n  succ:";
+		for (BasicBlock* s : b->getSucc())
+			out << " B" << s->getId();
+		out << "\n  pred:";
+		for (BasicBlock* p : b->getPred())
+			out << " B" << p->getId();
+		out << '\n';
+	}
+}
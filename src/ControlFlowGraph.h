@@ -0,0 +1,173 @@
+#ifndef __CONTROL_FLOW_GRAPH__
+#define __CONTROL_FLOW_GRAPH__
+
+#include <vector>
+#include <unordered_map>
+
+#include "IR.h"
+#include "BitSet.h"
+
+
+/**
+ * Straight-line run of instructions with a single entry (the first instruction) and a single
+ * exit (the last instruction). Holds the block level liveness summaries.
+ */
+class BasicBlock
+{
+public:
+	explicit BasicBlock(int id) : m_id(id), m_idom(nullptr), m_loopDepth(0) {}
+
+	// Vraća redni broj bloka (blokovi su numerisani redom kojim se pojavljuju u kodu)
+	int getId() const;
+
+	// Vraća instrukcije bloka u redosledu izvršavanja
+	std::vector<Instruction*>& getInstructions();
+
+	// Vraća sledbenike bloka
+	std::vector<BasicBlock*>& getSucc();
+
+	// Vraća prethodnike bloka
+	std::vector<BasicBlock*>& getPred();
+
+	// Vraća promenljive koje se koriste u bloku pre nego što se u njemu definišu (gen)
+	BitSet& getUse();
+
+	// Vraća promenljive koje se definišu u bloku (kill)
+	BitSet& getDef();
+
+	// Vraća promenljive žive na ulazu u blok
+	BitSet& getIn();
+
+	// Vraća promenljive žive na izlazu iz bloka
+	BitSet& getOut();
+
+	// Vraća neposrednog dominatora bloka (ulazni blok je sam sebi dominator, nedostižni blok nema dominatora)
+	BasicBlock* getIdom() const;
+
+	// Vraća broj petlji u kojima se blok nalazi
+	int getLoopDepth() const;
+
+private:
+	friend class ControlFlowGraph;
+
+	int m_id;
+	std::vector<Instruction*> m_instructions;
+	std::vector<BasicBlock*> m_succ;
+	std::vector<BasicBlock*> m_pred;
+	BitSet m_use;
+	BitSet m_def;
+	BitSet m_in;
+	BitSet m_out;
+	BasicBlock* m_idom;
+	int m_loopDepth;
+};
+
+
+/**
+ * Natural loop: the header and every block which reaches a back edge to the header
+ * without passing through it. Loops sharing a header are merged.
+ */
+struct Loop
+{
+	BasicBlock* header;
+	std::vector<BasicBlock*> blocks;
+};
+
+
+/**
+ * Control flow graph of one function made of basic blocks.
+ * Blocks start at the first instruction of the function, at every labeled instruction and
+ * after every branch (b, bltz, bne); they are kept in the order of the instruction list.
+ */
+class ControlFlowGraph
+{
+public:
+	ControlFlowGraph();
+	~ControlFlowGraph();
+
+	/**
+	 * Splits the instructions into basic blocks and links them.
+	 * The function pseudo instruction is not part of any block.
+	 * [in] instrs - instructions of the program
+	 */
+	void build(Instructions& instrs);
+
+	/**
+	 * Computes use (upward exposed uses) and def sets of every block
+	 * [in] numVars - number of register variables (size of the sets)
+	 */
+	void computeLocalSets(int numVars);
+
+	/**
+	 * Returns blocks in the order of the instruction list
+	 */
+	std::vector<BasicBlock*>& getBlocks();
+
+	/**
+	 * Returns the block where execution starts, or nullptr if the function is empty
+	 */
+	BasicBlock* getEntry();
+
+	/**
+	 * Returns the block which starts with the label (the function label gives the entry),
+	 * or nullptr if there is none
+	 */
+	BasicBlock* getBlockWithLabel(Variable* label);
+
+	/**
+	 * Returns blocks in postorder of a depth first walk from the entry,
+	 * unreachable blocks are appended at the end
+	 */
+	std::vector<BasicBlock*> postorder();
+
+	/**
+	 * Computes dominators (Cooper-Harvey-Kennedy) and the natural loops given by back edges,
+	 * and sets the loop depth of every block
+	 */
+	void computeLoops();
+
+	/**
+	 * Returns true if every path from the entry to block b passes through block a
+	 */
+	bool dominates(BasicBlock* a, BasicBlock* b) const;
+
+	/**
+	 * Returns natural loops found by computeLoops, inner loops come after the loops containing them
+	 */
+	std::vector<Loop>& getLoops();
+
+	/**
+	 * Deletes all blocks
+	 */
+	void clear();
+
+	/**
+	 * Prints blocks with their instructions and edges
+	 */
+	void print(std::ostream& out);
+
+private:
+	ControlFlowGraph(const ControlFlowGraph&);
+	ControlFlowGraph& operator=(const ControlFlowGraph&);
+
+	/**
+	 * Adds an edge between two blocks
+	 */
+	static void link(BasicBlock* from, BasicBlock* to);
+
+	/**
+	 * Depth first postorder from the given roots
+	 */
+	std::vector<BasicBlock*> depthFirstPostorder(const std::vector<BasicBlock*>& roots);
+
+	std::vector<BasicBlock*> m_blocks;                      // Blocks in instruction list order
+	std::vector<Loop> m_loops;                              // Natural loops
+	std::unordered_map<Variable*, BasicBlock*> m_labels;    // Block which starts with the given label
+};
+
+/**
+ * Returns true if the instruction is a branch (b, bltz or bne)
+ */
+bool isBranch(InstructionType type);
+
+#endif
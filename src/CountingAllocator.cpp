@@ -0,0 +1,40 @@
+#include "CountingAllocator.h"
+
+#include <cstdlib>
+#include <new>
+
+// Brojači alokacija, uvećavaju se u zamenjenom globalnom operatoru new (drajver radi u jednoj niti)
+static unsigned long long allocations = 0;
+static unsigned long long allocated = 0;
+
+void* operator new(std::size_t size)
+{
+	++allocations;
+	allocated += size;
+	void* p = std::malloc(size == 0 ? 1 : size);
+	if (p == nullptr)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+// Vraća broj alokacija
+unsigned long long allocationCount()
+{
+	return allocations;
+}
+
+// Vraća ukupnu veličinu alokacija
+unsigned long long allocatedBytes()
+{
+	return allocated;
+}
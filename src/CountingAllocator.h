@@ -0,0 +1,23 @@
+#ifndef __COUNTING_ALLOCATOR__
+#define __COUNTING_ALLOCATOR__
+
+
+/**
+ * Replacement of the global operator new and operator delete which counts heap allocations.
+ *
+ * Only the command line driver links it, the compiler library never replaces the allocator of
+ * the program it is embedded in. The driver passes the counters to TimeReport, which shows
+ * zero allocations when it has none.
+ */
+
+/**
+ * Number of heap allocations since the program started
+ */
+unsigned long long allocationCount();
+
+/**
+ * Total size of heap allocations in bytes since the program started
+ */
+unsigned long long allocatedBytes();
+
+#endif
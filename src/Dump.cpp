@@ -0,0 +1,67 @@
+#include "Dump.h"
+
+#include <stdexcept>
+
+Dump::Dump() : kinds(0)
+{
+}
+
+// Parsira listu imena ispisa razdvojenih zarezima
+bool Dump::parseList(const std::string& list, unsigned int& kinds)
+{
+	static const struct { const char* name; unsigned int kind; } names[] =
+	{
+		{ "tokens", DUMP_TOKENS },
+		{ "instructions", DUMP_INSTRUCTIONS },
+		{ "variables", DUMP_VARIABLES },
+		{ "cfg", DUMP_CFG },
+		{ "liveness", DUMP_LIVENESS },
+		{ "graph", DUMP_GRAPH },
+		{ "registers", DUMP_REGISTERS },
+		{ "passes", DUMP_PASSES },
+		{ "all", DUMP_ALL }
+	};
+
+	size_t begin = 0;
+	while (begin <= list.size())
+	{
+		size_t end = list.find(',', begin);
+		if (end == std::string::npos)
+			end = list.size();
+		std::string name = list.substr(begin, end - begin);
+
+		bool found = false;
+		for (const auto& n : names)
+			if (name == n.name)
+			{
+				kinds |= n.kind;
+				found = true;
+			}
+		if (!found)
+			return false;
+		begin = end + 1;
+	}
+	return true;
+}
+
+// Uključuje ispise
+void Dump::enable(unsigned int kinds)
+{
+	this->kinds |= kinds;
+}
+
+// Preusmerava ispise u fajl
+void Dump::setFile(const std::string& fileName)
+{
+	file.open(fileName);
+	if (!file)
+		throw std::runtime_error("\nException! Failed to open dump file " + fileName + "!\n");
+}
+
+// Vraća tok u koji se ispisuje
+std::ostream& Dump::stream()
+{
+	if (file.is_open())
+		return file;
+	return std::cout;
+}
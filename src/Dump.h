@@ -0,0 +1,71 @@
+#ifndef __DUMP__
+#define __DUMP__
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+
+/**
+ * Debug dumps which can be selected on the command line
+ */
+enum DumpKind
+{
+	DUMP_TOKENS       = 1 << 0,     // Token list after lexical analysis
+	DUMP_INSTRUCTIONS = 1 << 1,     // Instructions after syntax analysis
+	DUMP_VARIABLES    = 1 << 2,     // Variables after syntax analysis
+	DUMP_CFG          = 1 << 3,     // Basic blocks of every iteration of the liveness analysis
+	DUMP_LIVENESS     = 1 << 4,     // Instructions with in/out sets of every iteration of the liveness analysis
+	DUMP_GRAPH        = 1 << 5,     // Interference graph after allocation
+	DUMP_REGISTERS    = 1 << 6,     // Register variables with the assigned registers
+	DUMP_PASSES       = 1 << 7,     // Messages and statistics of the optimization passes
+	DUMP_ALL          = (1 << 8) - 1
+};
+
+/**
+ * Selection and destination of the debug dumps. Nothing is dumped by default.
+ *
+ * Callers check enabled() before formatting anything, so a run without dumps does no dump
+ * work at all:
+ *	if (dump.enabled(DUMP_LIVENESS))
+ *		print(instrs, dump.stream());
+ */
+class Dump
+{
+public:
+	Dump();
+
+	/**
+	 * Parses a comma separated list of dump names (tokens, instructions, variables, cfg,
+	 * liveness, graph, registers, passes, all)
+	 * [out] kinds - bitwise or of the selected DumpKind values
+	 * [out] return - false if the list contains an unknown name
+	 */
+	static bool parseList(const std::string& list, unsigned int& kinds);
+
+	/**
+	 * Enables the given dumps
+	 */
+	void enable(unsigned int kinds);
+
+	/**
+	 * Redirects the dumps to the file, throws runtime_error if it can't be opened
+	 */
+	void setFile(const std::string& fileName);
+
+	bool enabled(DumpKind kind) const
+	{
+		return (kinds & kind) != 0;
+	}
+
+	/**
+	 * Returns the stream dumps are written to (the dump file or the standard output)
+	 */
+	std::ostream& stream();
+
+private:
+	unsigned int kinds;
+	std::ofstream file;
+};
+
+#endif
@@ -0,0 +1,195 @@
+#include "ElfWriter.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace
+{
+	const unsigned int ET_REL = 1;
+	const unsigned int EM_MIPS = 8;
+	const unsigned int EF_MIPS_NOREORDER = 0x00000001;
+	const unsigned int EF_MIPS_ABI_O32 = 0x00001000;
+	const unsigned int EF_MIPS_ARCH_32 = 0x50000000;
+
+	const unsigned int SHT_PROGBITS = 1;
+	const unsigned int SHT_SYMTAB = 2;
+	const unsigned int SHT_STRTAB = 3;
+	const unsigned int SHT_REL = 9;
+	const unsigned int SHF_WRITE = 0x1;
+	const unsigned int SHF_ALLOC = 0x2;
+	const unsigned int SHF_EXECINSTR = 0x4;
+
+	const unsigned int STB_LOCAL = 0;
+	const unsigned int STB_GLOBAL = 1;
+	const unsigned int STT_NOTYPE = 0;
+	const unsigned int STT_OBJECT = 1;
+	const unsigned int STT_FUNC = 2;
+	const unsigned int STT_SECTION = 3;
+
+	// indeksi sekcija
+	enum { SEC_NULL, SEC_TEXT, SEC_DATA, SEC_REL_TEXT, SEC_SYMTAB, SEC_STRTAB, SEC_SHSTRTAB, SEC_COUNT };
+
+	const unsigned int EHDR_SIZE = 52;
+	const unsigned int SHDR_SIZE = 40;
+	const unsigned int SYM_SIZE = 16;
+	const unsigned int REL_SIZE = 8;
+}
+
+ElfWriter::ElfWriter(const ObjectCode& code) : code(code)
+{
+}
+
+// Dodaje vrednost u little-endian poretku
+void ElfWriter::put(std::vector<char>& image, unsigned int value, int bytes)
+{
+	for (int i = 0; i < bytes; ++i)
+		image.push_back((char)((value >> (8 * i)) & 0xff));
+}
+
+// Dodaje ime u tabelu stringova i vraća njegov pomeraj
+unsigned int ElfWriter::addString(std::string& table, const std::string& name)
+{
+	unsigned int offset = (unsigned int)table.size();
+	table += name;
+	table += '\0';
+	return offset;
+}
+
+// Dopunjuje sliku nulama do poravnanja
+void ElfWriter::align(std::vector<char>& image, size_t alignment)
+{
+	while (image.size() % alignment != 0)
+		image.push_back(0);
+}
+
+// Upisuje objektni fajl
+void ElfWriter::write(const std::string& fileName)
+{
+	// tabela simbola: nulti, simboli sekcija .text (1) i .data (2) i lokalni simboli, pa globalni
+	std::string strtab(1, '\0');
+	std::vector<char> symtab;
+	std::vector<int> symbolIndex(code.symbols.size());
+	put(symtab, 0, 4); put(symtab, 0, 4); put(symtab, 0, 4); put(symtab, 0, 1); put(symtab, 0, 1); put(symtab, 0, 2);
+	for (unsigned int section : { (unsigned int)SEC_TEXT, (unsigned int)SEC_DATA })
+	{
+		put(symtab, 0, 4); put(symtab, 0, 4); put(symtab, 0, 4);
+		put(symtab, (STB_LOCAL << 4) | STT_SECTION, 1); put(symtab, 0, 1); put(symtab, section, 2);
+	}
+	int count = 3;
+	int firstGlobal = 0;
+	for (int pass = 0; pass < 2; ++pass)
+	{
+		if (pass == 1)
+			firstGlobal = count;
+		for (unsigned int k = 0; k < code.symbols.size(); ++k)
+		{
+			const ObjectCode::Symbol& s = code.symbols[k];
+			if (s.global != (pass == 1))
+				continue;
+			unsigned int type = s.data ? STT_OBJECT : (s.function ? STT_FUNC : STT_NOTYPE);
+			put(symtab, addString(strtab, s.name), 4);
+			put(symtab, s.value, 4);
+			put(symtab, s.size, 4);
+			put(symtab, ((s.global ? STB_GLOBAL : STB_LOCAL) << 4) | type, 1);
+			put(symtab, 0, 1);
+			put(symtab, s.data ? SEC_DATA : SEC_TEXT, 2);
+			symbolIndex[k] = count++;
+		}
+	}
+
+	std::vector<char> rel;
+	for (const ObjectCode::Relocation& r : code.relocations)
+	{
+		put(rel, r.offset, 4);
+		unsigned int symbol = r.symbol == ObjectCode::DATA_SECTION ? 2 : (unsigned int)symbolIndex[r.symbol];
+		put(rel, (symbol << 8) | (unsigned int)r.type, 4);
+	}
+
+	std::string shstrtab(1, '\0');
+	unsigned int names[SEC_COUNT] = { 0 };
+	names[SEC_TEXT] = addString(shstrtab, ".text");
+	names[SEC_DATA] = addString(shstrtab, ".data");
+	names[SEC_REL_TEXT] = addString(shstrtab, ".rel.text");
+	names[SEC_SYMTAB] = addString(shstrtab, ".symtab");
+	names[SEC_STRTAB] = addString(shstrtab, ".strtab");
+	names[SEC_SHSTRTAB] = addString(shstrtab, ".shstrtab");
+
+	// sadržaj sekcija nakon zaglavlja, pa tabela zaglavlja sekcija
+	std::vector<char> image(EHDR_SIZE, 0);
+	unsigned int offsets[SEC_COUNT] = { 0 };
+	unsigned int sizes[SEC_COUNT] = { 0 };
+
+	offsets[SEC_TEXT] = (unsigned int)image.size();
+	for (unsigned int word : code.text)
+		put(image, word, 4);
+	sizes[SEC_TEXT] = (unsigned int)image.size() - offsets[SEC_TEXT];
+
+	offsets[SEC_DATA] = (unsigned int)image.size();
+	for (unsigned int word : code.data)
+		put(image, word, 4);
+	sizes[SEC_DATA] = (unsigned int)image.size() - offsets[SEC_DATA];
+
+	offsets[SEC_REL_TEXT] = (unsigned int)image.size();
+	image.insert(image.end(), rel.begin(), rel.end());
+	sizes[SEC_REL_TEXT] = (unsigned int)rel.size();
+
+	offsets[SEC_SYMTAB] = (unsigned int)image.size();
+	image.insert(image.end(), symtab.begin(), symtab.end());
+	sizes[SEC_SYMTAB] = (unsigned int)symtab.size();
+
+	offsets[SEC_STRTAB] = (unsigned int)image.size();
+	image.insert(image.end(), strtab.begin(), strtab.end());
+	sizes[SEC_STRTAB] = (unsigned int)strtab.size();
+
+	offsets[SEC_SHSTRTAB] = (unsigned int)image.size();
+	image.insert(image.end(), shstrtab.begin(), shstrtab.end());
+	sizes[SEC_SHSTRTAB] = (unsigned int)shstrtab.size();
+
+	align(image, 4);
+	unsigned int sectionHeaders = (unsigned int)image.size();
+	const unsigned int types[SEC_COUNT] = { 0, SHT_PROGBITS, SHT_PROGBITS, SHT_REL, SHT_SYMTAB, SHT_STRTAB, SHT_STRTAB };
+	const unsigned int flags[SEC_COUNT] = { 0, SHF_ALLOC | SHF_EXECINSTR, SHF_ALLOC | SHF_WRITE, 0, 0, 0, 0 };
+	const unsigned int links[SEC_COUNT] = { 0, 0, 0, SEC_SYMTAB, SEC_STRTAB, 0, 0 };
+	const unsigned int infos[SEC_COUNT] = { 0, 0, 0, SEC_TEXT, (unsigned int)firstGlobal, 0, 0 };
+	const unsigned int aligns[SEC_COUNT] = { 0, 4, 4, 4, 4, 1, 1 };
+	const unsigned int entries[SEC_COUNT] = { 0, 0, 0, REL_SIZE, SYM_SIZE, 0, 0 };
+	for (int k = 0; k < SEC_COUNT; ++k)
+	{
+		put(image, names[k], 4);
+		put(image, types[k], 4);
+		put(image, flags[k], 4);
+		put(image, 0, 4);
+		put(image, k == SEC_NULL ? 0 : offsets[k], 4);
+		put(image, sizes[k], 4);
+		put(image, links[k], 4);
+		put(image, infos[k], 4);
+		put(image, aligns[k], 4);
+		put(image, entries[k], 4);
+	}
+
+	// zaglavlje fajla
+	std::vector<char> header;
+	const char ident[16] = { 0x7f, 'E', 'L', 'F', 1 /* ELFCLASS32 */, 1 /* ELFDATA2LSB */, 1 /* EV_CURRENT */ };
+	header.insert(header.end(), ident, ident + 16);
+	put(header, ET_REL, 2);
+	put(header, EM_MIPS, 2);
+	put(header, 1, 4);
+	put(header, 0, 4);
+	put(header, 0, 4);
+	put(header, sectionHeaders, 4);
+	put(header, EF_MIPS_ARCH_32 | EF_MIPS_ABI_O32 | (code.noReorder ? EF_MIPS_NOREORDER : 0), 4);
+	put(header, EHDR_SIZE, 2);
+	put(header, 0, 2);
+	put(header, 0, 2);
+	put(header, SHDR_SIZE, 2);
+	put(header, SEC_COUNT, 2);
+	put(header, SEC_SHSTRTAB, 2);
+	std::copy(header.begin(), header.end(), image.begin());
+
+	std::ofstream file(fileName, std::ios::binary);
+	if (!file.is_open())
+		throw std::runtime_error("\nException! Wasn\'t able to create the object file " + fileName + "!");
+	file.write(image.data(), image.size());
+	if (!file)
+		throw std::runtime_error("\nException! Wasn\'t able to write the object file " + fileName + "!");
+}
@@ -0,0 +1,46 @@
+#ifndef __ELF_WRITER__
+#define __ELF_WRITER__
+
+#include "MipsEncoder.h"
+
+#include <string>
+#include <vector>
+
+
+/**
+ * Writes encoded code as a relocatable little-endian ELF32 MIPS object (o32 ABI) with the
+ * sections .text, .data, .rel.text, .symtab, .strtab and .shstrtab
+ */
+class ElfWriter
+{
+public:
+	/**
+	 * [in] code - encoded function and memory variables
+	 */
+	ElfWriter(const ObjectCode& code);
+
+	/**
+	 * Writes the object file, throws runtime_error if it can't be written
+	 */
+	void write(const std::string& fileName);
+
+private:
+	/**
+	 * Appends a little-endian value of the given size (1, 2 or 4 bytes) to the image
+	 */
+	void put(std::vector<char>& image, unsigned int value, int bytes);
+
+	/**
+	 * Appends the name to the string table and returns its offset
+	 */
+	static unsigned int addString(std::string& table, const std::string& name);
+
+	/**
+	 * Pads the image with zeros to the alignment
+	 */
+	static void align(std::vector<char>& image, size_t alignment);
+
+	const ObjectCode& code;
+};
+
+#endif
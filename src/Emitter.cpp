@@ -0,0 +1,177 @@
+#include "Emitter.h"
+
+#include <stdexcept>
+
+namespace
+{
+	/**
+	 * Operand layout of an instruction type: mnemonic and operands, where
+	 * 'd' is the next destination and 's' the next source, other characters are copied
+	 */
+	struct Layout
+	{
+		const char* mnemonic;
+		const char* operands;
+	};
+
+	// indeksirano sa InstructionType
+	const Layout layouts[] =
+	{
+		{ "", "" },                 // I_NO_TYPE
+		{ "add", "d, s, s" },       // I_ADD
+		{ "addi", "d, s, s" },      // I_ADDI
+		{ "sub", "d, s, s" },       // I_SUB
+		{ "la", "d, s" },           // I_LA
+		{ "li", "d, s" },           // I_LI
+		{ "lw", "d, s(s)" },        // I_LW
+		{ "sw", "s, s(s)" },        // I_SW
+		{ "bltz", "s, s" },         // I_BLTZ
+		{ "b", "s" },               // I_B
+		{ "nop", "" },              // I_NOP
+		{ "and", "d, s, s" },       // I_AND
+		{ "or", "d, s, s" },        // I_OR
+		{ "not", "d, s" },          // I_NOT
+		{ "bne", "s, s, s" }        // I_BNE
+	};
+}
+
+Emitter::Emitter(const std::string& fileName)
+{
+	file = fopen(fileName.c_str(), "wb");
+	if (file == nullptr)
+		throw std::runtime_error("\nException! Wasn\'t able to create the output file!");
+	buffer.reserve(BUFFER_SIZE + 4096);
+}
+
+Emitter::~Emitter()
+{
+	if (file != nullptr)
+		fclose(file);
+}
+
+// Ispisuje ceo asemblerski fajl
+void Emitter::emit(Instructions& instrs, Variables& memVars, bool noReorder)
+{
+	buffer += ".globl ";
+	buffer += instrs.front()->getLabel()->getName();
+	buffer += "\n\n.data\n";
+	for (Variable* v : memVars)
+	{
+		buffer += v->getName();
+		buffer += ":\t.word ";
+		appendNumber(buffer, v->getValue());
+		buffer += '\n';
+		flushIfFull();
+	}
+
+	buffer += "\n.text\n";
+	if (noReorder)
+		buffer += ".set noreorder\n";
+	for (Instruction* i : instrs)
+	{
+		appendInstruction(buffer, i);
+		buffer += '\n';
+		flushIfFull();
+	}
+
+	buffer += "\tjr $ra";
+	if (noReorder)
+		buffer += "\n\tnop";
+	flush();
+
+	if (fclose(file) != 0)
+	{
+		file = nullptr;
+		throw std::runtime_error("\nException! Wasn\'t able to write the output file!");
+	}
+	file = nullptr;
+}
+
+// Dodaje instrukciju sa labelom u tekst
+void Emitter::appendInstruction(std::string& text, Instruction* in)
+{
+	if (in->getLabel() != nullptr)
+	{
+		text += in->getLabel()->getName();
+		text += ':';
+		if (in->isFunc())
+			return;
+		text += '\n';
+	}
+	text += '\t';
+
+	const Layout& layout = layouts[in->getType()];
+	text += layout.mnemonic;
+	if (*layout.operands == '\0')
+		return;
+	text += ' ';
+
+	Operands::iterator dst = in->getDst().begin();
+	Operands::iterator src = in->getSrc().begin();
+	for (const char* c = layout.operands; *c != '\0'; ++c)
+	{
+		if (*c == 'd')
+			appendOperand(text, *dst++);
+		else if (*c == 's')
+			appendOperand(text, *src++);
+		else
+			text += *c;
+	}
+}
+
+// Dodaje operand u tekst
+void Emitter::appendOperand(std::string& text, Variable* var)
+{
+	switch (var->getType())
+	{
+	case Variable::REG_VAR:
+		if (var->getAssignment() == no_assign)
+			text += "error";
+		else
+			text += var->getRegisterName();
+		break;
+	case Variable::CONST_VAR:
+		appendNumber(text, var->getValue());
+		break;
+	case Variable::LABEL_VAR:
+	case Variable::MEM_VAR:
+		text += var->getName();
+		break;
+	default:
+		text += "error";
+		break;
+	}
+}
+
+// Dodaje ceo broj u tekst
+void Emitter::appendNumber(std::string& text, int value)
+{
+	char digits[12];
+	int length = 0;
+	unsigned int magnitude = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+	do
+	{
+		digits[length++] = (char)('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude != 0);
+
+	if (value < 0)
+		text += '-';
+	while (length > 0)
+		text += digits[--length];
+}
+
+// Upisuje bafer u fajl kada se napuni
+void Emitter::flushIfFull()
+{
+	if (buffer.size() >= BUFFER_SIZE)
+		flush();
+}
+
+// Upisuje bafer u fajl
+void Emitter::flush()
+{
+	if (!buffer.empty() && fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size())
+		throw std::runtime_error("\nException! Wasn\'t able to write the output file!");
+	buffer.clear();
+}
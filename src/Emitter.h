@@ -0,0 +1,65 @@
+#ifndef __EMITTER__
+#define __EMITTER__
+
+#include "IR.h"
+
+#include <cstdio>
+#include <string>
+
+
+/**
+ * Writes the assembly file.
+ *
+ * Every line is formatted directly into one reusable buffer from the operand layout of its
+ * instruction type, so emitting an instruction allocates nothing. The buffer is written to the
+ * file with a single fwrite whenever it fills up and once at the end.
+ */
+class Emitter
+{
+public:
+	/**
+	 * Opens the output file, throws runtime_error if it can't be created
+	 */
+	Emitter(const std::string& fileName);
+	~Emitter();
+
+	/**
+	 * Writes the .data section with the memory variables and the .text section with the
+	 * instructions followed by the return from the function
+	 * [in] noReorder - branch delay slots are filled, the assembler must not reorder the code
+	 */
+	void emit(Instructions& instrs, Variables& memVars, bool noReorder);
+
+	/**
+	 * Appends the instruction (with its label, without the new line) to the text
+	 */
+	static void appendInstruction(std::string& text, Instruction* in);
+
+private:
+	/**
+	 * Appends the operand as it is written in the assembly
+	 */
+	static void appendOperand(std::string& text, Variable* var);
+
+	/**
+	 * Appends a decimal integer without creating a temporary string
+	 */
+	static void appendNumber(std::string& text, int value);
+
+	/**
+	 * Writes the buffer to the file if it's filled up
+	 */
+	void flushIfFull();
+
+	/**
+	 * Writes the whole buffer to the file
+	 */
+	void flush();
+
+	static const size_t BUFFER_SIZE = 1 << 20;
+
+	FILE* file;
+	std::string buffer;
+};
+
+#endif
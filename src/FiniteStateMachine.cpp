@@ -142,42 +142,34 @@ TokenType FiniteStateMachine::getTokenType(int stateNumber)
 }
 
 
+FiniteStateMachine::FiniteStateMachine()
+{
+	initStateMachine();
+}
+
+
 void FiniteStateMachine::initStateMachine()
 {
 	for (int i = 0; i < NUM_STATES; i++)
 	{
-		map<char, int> stateTransitions;
+		for (int c = 0; c < NUM_OF_BYTES; c++)
+		{
+			transitionTable[i][c] = INVALID_STATE;
+		}
 		for (int j = 0; j < NUM_OF_CHARACTERS; j++)
 		{
-			stateTransitions[supportedCharacters[j]] = stateMatrix[i][j];
+			transitionTable[i][(unsigned char)supportedCharacters[j]] = stateMatrix[i][j];
 		}
-		stateMachine[i] = stateTransitions;
 	}
 }
 
 
-int FiniteStateMachine::getNextState(int currentState, char transitionLetter)
+void FiniteStateMachine::throwInvalidState(int currentState)
 {
-	StateMachine::iterator it = stateMachine.find(currentState);
-	
-	if (it == stateMachine.end())
-	{
-		string strCurrentState;
-		stringstream ss;
-		ss << currentState;
-		ss >> strCurrentState;
-		string errMessage = "\nEXCEPTION: currentState = " + strCurrentState + " is not a valid state!";
-		throw runtime_error(errMessage.c_str());
-	}
-
-	map<char, int>::iterator cit = it->second.find(transitionLetter);
-
-	if (cit == it->second.end())
-	{
-		return INVALID_STATE;
-	}
-	else
-	{
-		return cit->second;
-	}
+	string strCurrentState;
+	stringstream ss;
+	ss << currentState;
+	ss >> strCurrentState;
+	string errMessage = "\nEXCEPTION: currentState = " + strCurrentState + " is not a valid state!";
+	throw runtime_error(errMessage.c_str());
 }
@@ -1,25 +1,38 @@
 #ifndef __FINITE_STATE_MACHINE__
 #define __FINITE_STATE_MACHINE__
 
-#include <map>
 #include <string>
 
 #include "Constants.h"
 #include "Types.h"
 
-typedef std::map<int, std::map<char,int>> StateMachine;
+/**
+ * Flat transition table: one row per state, one column per possible input byte
+ */
+typedef int TransitionTable[NUM_STATES][NUM_OF_BYTES];
 
 class FiniteStateMachine
 {
 public:
+	/**
+	 * Builds the transition table, so the FSM is usable right after construction
+	 */
+	FiniteStateMachine();
+
 	/**
 	 * Returns the next state number, based on current state and transition letter
 	 */
-	int getNextState(int currentState, char transitionLetter);
+	int getNextState(int currentState, char transitionLetter)
+	{
+		if (currentState < 0 || currentState >= NUM_STATES)
+			throwInvalidState(currentState);
+
+		return transitionTable[currentState][(unsigned char)transitionLetter];
+	}
 
 	/**
-	 * Call this function to initialize FSM.
-	 * This function must be called before getNextLexToken function.
+	 * Call this function to (re)initialize FSM.
+	 * Fills the flat transition table from stateMatrix and supportedCharacters.
 	 */
 	void initStateMachine();
 
@@ -30,13 +43,16 @@ public:
 
 private:
 	/**
-	 * State machine map, containing possible FSM states and transition matrix as an inner map
-	 *		map<StateNumber, map<TransitionCharacter, NextStateNumber>>
-	 * map1 key:		state number
-	 * map1 value:	map2 key -> next letter in the stream, identifies the transition to the next state
-	 *				map2 value -> next state number
+	 * Transition table indexed by [state][byte], so every lexed character costs a single load
+	 *	transitionTable[state][byte] -> next state number
+	 * Bytes which are not in supportedCharacters map to INVALID_STATE
+	 */
+	TransitionTable transitionTable;
+
+	/**
+	 * Raises an exception for a state number outside of the transition table
 	 */
-	StateMachine stateMachine;
+	static void throwInvalidState(int currentState);
 
 	/**
 	 * Table used for mapping states to tokens
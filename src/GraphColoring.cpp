@@ -0,0 +1,168 @@
+#include "GraphColoring.h"
+
+#include <algorithm>
+
+GraphColoring::GraphColoring(const InterferenceGraph& graph, int numRegs) :
+	m_graph(graph), m_numRegs(numRegs), m_size(graph.size()),
+	m_costs(graph.size(), 1.0), m_degree(graph.size()), m_removed(graph.size(), false),
+	m_bucketHead(numRegs, -1), m_next(graph.size(), -1), m_prev(graph.size(), -1),
+	m_spillHeap(), m_stack(), m_colors(graph.size(), 0), m_spilled()
+{
+}
+
+// Postavlja cenu prosipanja svakog čvora
+void GraphColoring::setSpillCosts(const std::vector<double>& costs)
+{
+	m_costs = costs;
+}
+
+// Vraća boju čvora
+int GraphColoring::getColor(int node) const
+{
+	return m_colors[node];
+}
+
+// Vraća čvorove koji nisu dobili boju
+const std::vector<int>& GraphColoring::getSpilled() const
+{
+	return m_spilled;
+}
+
+// Izbacuje čvor iz liste u kojoj se nalazi
+void GraphColoring::unlink(int node)
+{
+	if (m_prev[node] != -1)
+		m_next[m_prev[node]] = m_next[node];
+	else
+		m_bucketHead[m_degree[node]] = m_next[node];
+	if (m_next[node] != -1)
+		m_prev[m_next[node]] = m_prev[node];
+	m_next[node] = -1;
+	m_prev[node] = -1;
+}
+
+// Ubacuje čvor u listu njegovog stepena
+void GraphColoring::link(int node)
+{
+	int& head = m_bucketHead[m_degree[node]];
+	m_prev[node] = -1;
+	m_next[node] = head;
+	if (head != -1)
+		m_prev[head] = node;
+	head = node;
+}
+
+// Uklanja čvor iz grafa i smanjuje stepen njegovim susedima
+void GraphColoring::removeNode(int node)
+{
+	m_removed[node] = true;
+	m_stack.push_back(node);
+
+	for (int n : m_graph.neighbors(node))
+	{
+		if (m_removed[n])
+			continue;
+		if (m_degree[n] < m_numRegs)
+		{
+			unlink(n);
+			--m_degree[n];
+			link(n);
+		}
+		else if (--m_degree[n] < m_numRegs)
+		{
+			// čvor velikog stepena je postao čvor malog stepena
+			link(n);
+		}
+	}
+}
+
+// Bira čvor velikog stepena sa najmanjim odnosom cene i stepena
+int GraphColoring::pickSpillCandidate()
+{
+	while (!m_spillHeap.empty())
+	{
+		std::pop_heap(m_spillHeap.begin(), m_spillHeap.end());
+		Candidate c = m_spillHeap.back();
+		m_spillHeap.pop_back();
+
+		if (m_removed[c.node] || m_degree[c.node] < m_numRegs)
+			continue;
+		if (c.degree != m_degree[c.node])
+		{
+			// stepen se u međuvremenu smanjio, čvor se vraća sa novim prioritetom
+			Candidate updated = { m_costs[c.node] / m_degree[c.node], c.node, m_degree[c.node] };
+			m_spillHeap.push_back(updated);
+			std::push_heap(m_spillHeap.begin(), m_spillHeap.end());
+			continue;
+		}
+		return c.node;
+	}
+	return -1;
+}
+
+// Pravi stek simplifikacije
+void GraphColoring::simplify()
+{
+	m_stack.clear();
+	m_stack.reserve(m_size);
+	m_spillHeap.clear();
+
+	for (int i = 0; i < m_size; ++i)
+	{
+		m_degree[i] = m_graph.degree(i);
+		if (m_degree[i] < m_numRegs)
+		{
+			link(i);
+		}
+		else
+		{
+			Candidate c = { m_costs[i] / m_degree[i], i, m_degree[i] };
+			m_spillHeap.push_back(c);
+		}
+	}
+	std::make_heap(m_spillHeap.begin(), m_spillHeap.end());
+
+	while ((int)m_stack.size() < m_size)
+	{
+		// čvor najvećeg stepena koji je manji od broja registara
+		int node = -1;
+		for (int d = m_numRegs - 1; d >= 0 && node == -1; --d)
+			node = m_bucketHead[d];
+
+		if (node != -1)
+		{
+			unlink(node);
+		}
+		else
+		{
+			// optimistično uklanjanje kandidata za prosipanje (Briggs)
+			node = pickSpillCandidate();
+		}
+		removeNode(node);
+	}
+}
+
+// Dodeljuje boje čvorovima obrnutim redosledom uklanjanja
+void GraphColoring::select()
+{
+	m_spilled.clear();
+	std::vector<int> usedBy(m_numRegs + 1, -1);
+
+	for (std::vector<int>::reverse_iterator it = m_stack.rbegin(); it != m_stack.rend(); ++it)
+	{
+		int node = *it;
+		for (int n : m_graph.neighbors(node))
+			usedBy[m_colors[n]] = node;
+
+		m_colors[node] = 0;
+		for (int c = 1; c <= m_numRegs; ++c)
+			if (usedBy[c] != node)
+			{
+				m_colors[node] = c;
+				break;
+			}
+
+		if (m_colors[node] == 0)
+			m_spilled.push_back(node);
+	}
+}
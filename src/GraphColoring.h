@@ -0,0 +1,102 @@
+#ifndef __GRAPH_COLORING__
+#define __GRAPH_COLORING__
+
+#include <vector>
+
+#include "InterferenceGraph.h"
+
+
+/**
+ * Chaitin-Briggs graph coloring register allocator.
+ *
+ * Simplify removes nodes of degree lower than the number of registers, taking them from
+ * degree buckets (highest low degree first) so every removal and every degree update is O(1).
+ * When only high degree nodes remain, the one with the lowest spill cost / degree is removed
+ * optimistically (Briggs) instead of giving up. Select pops the nodes and gives each the
+ * lowest register its colored neighbours do not use; a node with no free register is spilled.
+ * The whole allocation is O(nodes + edges) apart from the spill candidate heap.
+ */
+class GraphColoring
+{
+public:
+	/**
+	 * [in] graph   - interference graph, nodes are variable positions
+	 * [in] numRegs - number of registers (colors 1..numRegs)
+	 */
+	GraphColoring(const InterferenceGraph& graph, int numRegs);
+
+	/**
+	 * Sets spill cost of every node, nodes with a higher cost are spilled later.
+	 * Without costs every node costs 1.
+	 */
+	void setSpillCosts(const std::vector<double>& costs);
+
+	/**
+	 * Returns the color (1..numRegs) of the node, 0 if the node was spilled
+	 */
+	int getColor(int node) const;
+
+	/**
+	 * Returns the nodes which did not get a color
+	 */
+	const std::vector<int>& getSpilled() const;
+
+	/**
+	 * Builds the simplification stack
+	 */
+	void simplify();
+
+	/**
+	 * Pops the simplification stack and assigns colors (called after simplify), the nodes
+	 * which have to be spilled are then returned by getSpilled()
+	 */
+	void select();
+
+private:
+	/**
+	 * Removes the node from the degree bucket it is in
+	 */
+	void unlink(int node);
+
+	/**
+	 * Puts the node into the bucket of its current degree
+	 */
+	void link(int node);
+
+	/**
+	 * Removes the node from the graph, pushes it to the stack and lowers degrees of its neighbours
+	 */
+	void removeNode(int node);
+
+	/**
+	 * Returns the high degree node with the lowest spill cost / degree, -1 if there is none
+	 */
+	int pickSpillCandidate();
+
+	const InterferenceGraph& m_graph;
+	int m_numRegs;
+	int m_size;
+
+	std::vector<double> m_costs;
+	std::vector<int> m_degree;              // Degree in the graph of not yet removed nodes
+	std::vector<bool> m_removed;
+
+	std::vector<int> m_bucketHead;          // First node of every low degree bucket (0..numRegs-1)
+	std::vector<int> m_next;                // Links of the doubly linked bucket lists
+	std::vector<int> m_prev;
+
+	struct Candidate
+	{
+		double priority;
+		int node;
+		int degree;
+		bool operator<(const Candidate& other) const { return priority > other.priority; }
+	};
+	std::vector<Candidate> m_spillHeap;     // High degree nodes ordered by cost / degree (lazy updates)
+
+	std::vector<int> m_stack;               // Simplification stack
+	std::vector<int> m_colors;
+	std::vector<int> m_spilled;
+};
+
+#endif
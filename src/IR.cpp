@@ -1,11 +1,13 @@
 ﻿/* Autor: Kristina Mladenović Datum: 05.06.2024. */
 
 #include "IR.h"
+#include "Emitter.h"
+
+#include <algorithm>
 
 // ***********************************************
 // *            Variable methods                 *
 // ***********************************************
-unsigned Variable::counter = 0; // Brojač za varijable
 
 // Vraća referencu na ime varijable
 std::string& Variable::getName()
@@ -31,26 +33,38 @@ Regs& Variable::getAssignment()
 	return m_assignment;
 }
 
+// Dodeljuje registar varijabli
+void Variable::assign(Regs reg, const std::string& registerName)
+{
+	m_assignment = reg;
+	m_register = registerName;
+}
+
 // Vraća poziciju varijable
 int Variable::getPos() const
 {
 	return m_position;
 }
 
+// Postavlja poziciju varijable
+void Variable::setPos(int pos)
+{
+	m_position = pos;
+}
+
+// Vraća ime dodeljenog registra
+const std::string& Variable::getRegisterName() const
+{
+	return m_register;
+}
+
 // Vraća reprezentaciju varijable u string formatu u zavisnosti od njenog tipa
 std::string Variable::get()
 {
 	switch (m_type)
 	{
 	case REG_VAR:
-		switch (m_assignment)
-		{
-		case t0:	return "$t0";
-		case t1:	return "$t1";
-		case t2:    return "$t2";
-		case t3:    return "$t3";
-		default:	return "error";
-		}
+		return m_assignment == no_assign ? "error" : m_register;
 	case CONST_VAR:
 		return std::to_string(value);
 	case LABEL_VAR:
@@ -86,32 +100,52 @@ std::string Variable::printType()
 }
 
 // Ispisuje tabelu sa informacijama o varijabli
-void Variable::printTable()
+void Variable::printTable(std::ostream& out)
 {
-	using std::cout;
-	cout << ">-------<==========>-------<\n"
+	out << ">-------<==========>-------<\n"
 		<< "|       | Variable |       |\n"
 		<< ">-------<==========>-------<\n"
 		<< "> Name : " << m_name << '\n'
 		<< "> Type : " << printType() << '\n'
 		<< "> Value: ";
 	if (m_type == REG_VAR)
-		cout << get() << '\n';
+		out << get() << '\n';
 	else
-		cout << value << '\n';
+		out << value << '\n';
 }
 
 // Ispisuje tabelu sa informacijama o listi varijabli
-void print(std::list<Variable*>& vars)
+void print(std::list<Variable*>& vars, std::ostream& out)
 {
 	for (Variable* v : vars)
-		v->printTable();
+		v->printTable(out);
+}
+
+// ***********************************************
+// *              Operands methods               *
+// ***********************************************
+
+// Dodaje operand
+void Operands::push_back(Variable* var)
+{
+	if (m_size == CAPACITY)
+		throw std::runtime_error("Instruction can't have more than " + std::to_string(CAPACITY) + " operands!");
+	m_vars[m_size++] = var;
+}
+
+// Uklanja ponovljene operande
+void Operands::unique()
+{
+	unsigned int kept = 0;
+	for (unsigned int i = 0; i < m_size; ++i)
+		if (std::find(m_vars, m_vars + kept, m_vars[i]) == m_vars + kept)
+			m_vars[kept++] = m_vars[i];
+	m_size = kept;
 }
 
 // ***********************************************
 // *            Instruction methods              *
 // ***********************************************
-unsigned Instruction::counter = 0; // Brojač za instrukcije
 
 // Dodaje labelu instrukcije
 void Instruction::addLabel(Variable* lab)
@@ -121,6 +155,12 @@ void Instruction::addLabel(Variable* lab)
 		throw std::runtime_error("Not able to attach a non label variable to the instruction!");
 }
 
+// Uklanja labelu instrukcije
+void Instruction::removeLabel()
+{
+	label = nullptr;
+}
+
 // Dodaje odredište instrukcije
 void Instruction::addDst(Variable* var)
 {
@@ -133,23 +173,29 @@ void Instruction::addSrc(Variable* var)
 	m_src.push_back(var);
 }
 
-// Dodaje prethodnika instrukcije
-void Instruction::addPred(Instruction* in)
+// Zamenjuje varijablu u odredištima i izvorima instrukcije
+void Instruction::replaceVariable(Variable* from, Variable* to)
+{
+	std::replace(m_dst.begin(), m_dst.end(), from, to);
+	std::replace(m_src.begin(), m_src.end(), from, to);
+}
+
+// Postavlja poziciju instrukcije
+void Instruction::setPos(int pos)
 {
-	if (!contains(m_pred, in))
-		m_pred.push_back(in);
+	m_position = pos;
 }
 
-// Dodaje sledbenika instrukcije
-void Instruction::addSucc(Instruction* in)
+// Vraća poziciju instrukcije
+int Instruction::getPos() const
 {
-	if (!contains(m_succ, in))
-		m_succ.push_back(in);
+	return m_position;
 }
 
 // Postavlja upotrebu (use) varijabli
 void Instruction::setUse()
 {
+	m_use.clear();
 	for (Variable* v : m_src)
 		if (v->getType() == Variable::REG_VAR)
 			m_use.push_back(v);
@@ -159,6 +205,7 @@ void Instruction::setUse()
 // Postavlja definiciju (def) varijabli
 void Instruction::setDef()
 {
+	m_def.clear();
 	for (Variable* v : m_dst)
 		if (v->getType() == Variable::REG_VAR)
 			m_def.push_back(v);
@@ -177,85 +224,42 @@ Variable* Instruction::getLabel() const
 	return label;
 }
 
-// Vraća izvore instrukcije
-Variables& Instruction::getSrc()
+// Vraća odredišta instrukcije
+Operands& Instruction::getDst()
 {
-	return m_src;
+	return m_dst;
 }
 
-// Vraća skup varijabli ulaza instrukcije
-Variables& Instruction::getIn()
+// Vraća izvore instrukcije
+Operands& Instruction::getSrc()
 {
-	return m_in;
+	return m_src;
 }
 
 // Vraća skup varijabli izlaza instrukcije
-Variables& Instruction::getOut()
+LiveVariables& Instruction::getOut()
 {
 	return m_out;
 }
 
-// Vraća skup definisanih varijabli instrukcije
-Variables& Instruction::getDef()
-{
-	return m_def;
-}
-
-
-// Vraća listu sledbenika instrukcije
-Variables Instruction::getSuccIns()
+// Proverava da li je varijabla živa nakon instrukcije (binarnom pretragom po poziciji)
+bool Instruction::isLiveOut(Variable* var) const
 {
-	Variables vars;
-	for (Instruction* s : m_succ)
-		for (Variable* v : s->m_in)
-			if (!contains(vars, v))
-				vars.push_back(v);
-	return vars;
+	LiveVariables::const_iterator it = std::lower_bound(m_out.begin(), m_out.end(), var,
+		[](const Variable* a, const Variable* b) { return a->getPos() < b->getPos(); });
+	return it != m_out.end() && *it == var;
 }
 
-// Vraća listu varijabli korišćenih, ali ne i definisanih u instrukciji
-Variables Instruction::getUseWithOutWithoutDef()
-{
-	Variables vars;
-	for (Variable* v : m_out)
-		if (!contains(m_def, v))
-			vars.push_back(v);
-	for (Variable* v : m_use)
-		if (!contains(vars, v))
-			vars.push_back(v);
-	return vars;
-}
-
-// Pronalazi instrukciju sa datom labelom
-Instruction* findInstructionWithLabel(Variable* lab, std::list<Instruction*>& ins)
-{
-	for (Instructions::iterator it = ins.begin(); it != ins.end(); ++it)
-		if ((*it)->label == lab)
-			return *it;
-
-	throw std::runtime_error("No instruction with " + lab->getName() + " exists!");
-}
-
-// Pronalazi instrukciju koja sledi nakon funkcije
-Instruction* findInstructionAfterFunc(Instruction* in, std::list<Instruction*>& ins)
+// Vraća skup definisanih varijabli instrukcije
+Operands& Instruction::getDef()
 {
-	for (Instructions::iterator it = ins.begin(); it != ins.end(); ++it)
-	{
-		if (*it == in)
-		{
-			++it;
-			if (it != ins.end())
-				return *it;
-		}
-	}
-	return nullptr;
+	return m_def;
 }
 
-// Dodaje dve instrukcije kao prethodnika i sledbenika jedna drugoj
-void addEachother(Instruction& successor, Instruction& predecessor)
+// Vraća skup varijabli koje instrukcija koristi
+Operands& Instruction::getUse()
 {
-	successor.addPred(&predecessor);
-	predecessor.addSucc(&successor);
+	return m_use;
 }
 
 // Proverava da li je instrukcija funkcija
@@ -267,15 +271,6 @@ bool Instruction::isFunc()
 		return false;
 }
 
-// Vrši zamenu dela stringa
-void replace(std::string& what, std::string& with)
-{
-	if (what.find("\'") == -1)
-		return;
-
-	what.replace(what.find("\'"), 2, with);
-}
-
 // Vraća string reprezentaciju instrukcije
 std::string Instruction::toString()
 {
@@ -333,56 +328,59 @@ std::string Instruction::toString()
 // Preklopljen operator za ispis instrukcije u stream
 std::ostream& operator<<(std::ostream& out, Instruction& in)
 {
-	std::string val = in.toString();
-	if (in.label != nullptr)
-		val = in.label->get() + ":" + (in.isFunc() ? "" : "\n\t") + val;
-	else
-		val = "\t" + val;
-
-	for (Variable* dst : in.m_dst)
-		replace(val, dst->get());
-	for (Variable* src : in.m_src)
-		replace(val, src->get());
-
+	std::string val;
+	Emitter::appendInstruction(val, &in);
 	out << val;
 	return out;
 }
 
 // Ispisuje tabelu sa informacijama o instrukciji
-void Instruction::printTable()
+void Instruction::printTable(std::ostream& out)
 {
-	using std::cout;
-	cout << "=------===============------="
+	out << "=------===============------="
 		<< "\n|      | Instruction |      |"
 		<< "\n=------===============------="
 		<< "\n|  pos | " << m_position
 		<< "\n| type | " << toString()
 		<< "\n|  use |";
 	for (Variable* v : m_use)
-		std::cout << ' ' << v->getName();
-	cout << "\n|  def |";
+		out << ' ' << v->getName();
+	out << "\n|  def |";
 	for (Variable* v : m_def)
-		std::cout << ' ' << v->getName();
-	cout << "\n| succ |";
-	for (Instruction* i : m_succ)
-		std::cout << ' ' << i->m_position;
-	cout << "\n| pred |";
-	for (Instruction* i : m_pred)
-		std::cout << ' ' << i->m_position;
-	cout << "\n|   in |";
-	for (Variable* v : m_in)
-		std::cout << ' ' << v->getName();
-	cout << "\n|  out |";
+		out << ' ' << v->getName();
+	out << "\n|   in |";
+	for (Variable* v : m_use)
+		out << ' ' << v->getName();
+	for (Variable* v : m_out)
+		if (!contains(m_def, v) && !contains(m_use, v))
+			out << ' ' << v->getName();
+	out << "\n|  out |";
 	for (Variable* v : m_out)
-		std::cout << ' ' << v->getName();
-	cout << std::endl;
+		out << ' ' << v->getName();
+	out << std::endl;
 }
 
 // Ispisuje tabelu sa informacijama o listi instrukcija
-void print(std::list<Instruction*>& ins)
+void print(std::list<Instruction*>& ins, std::ostream& out)
 {
 	for (Instruction* i : ins)
-		i->printTable();
+		i->printTable(out);
+}
+
+// Uklanja instrukciju iz liste, labela prelazi na sledeću instrukciju
+bool removeInstruction(Instructions& ins, Instructions::iterator it)
+{
+	Instruction* in = *it;
+	if (in->label != nullptr)
+	{
+		Instructions::iterator next = it;
+		++next;
+		if (next == ins.end() || (*next)->label != nullptr)
+			return false;
+		(*next)->label = in->label;
+	}
+	ins.erase(it);
+	return true;
 }
 
 // Proverava da li lista instrukcija sadrži određenu instrukciju
@@ -402,3 +400,9 @@ bool contains(Variables& vars, Variable* var)
 			return true;
 	return false;
 }
+
+// Proverava da li operandi sadrže određenu varijablu
+bool contains(const Operands& vars, Variable* var)
+{
+	return std::find(vars.begin(), vars.end(), var) != vars.end();
+}
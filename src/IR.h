@@ -25,10 +25,8 @@ public:
 	//Variable(std::string name, int pos) : m_type(NO_TYPE), m_name(name), m_position(pos), m_assignment(no_assign) {}
 
 	Variable() : m_type(NO_TYPE), m_name(""), m_position(-1), m_assignment(no_assign), value(-1) {}
-	Variable(VariableType type, std::string name, int val = 0) : m_type(type), m_name(name), m_assignment(no_assign), value(val)
-	{
-		m_position = m_type == REG_VAR ? counter++ : -1;
-	}
+	Variable(VariableType type, std::string name, int val = 0) :
+		m_type(type), m_name(name), m_position(-1), m_assignment(no_assign), value(val) {}
 
 	// Metod za dobijanje imena promenljive
 	std::string& getName();
@@ -42,9 +40,18 @@ public:
 	// Metod za dobijanje dodele promenljive
 	Regs& getAssignment();
 
+	// Dodeljuje promenljivoj registar sa datim rednim brojem i imenom iz opisa ciljne arhitekture
+	void assign(Regs reg, const std::string& registerName);
+
 	// Konstantni metod za dobijanje pozicije promenljive
 	int getPos() const;
 
+	// Postavlja poziciju promenljive (pri prenumeraciji nakon dodavanja ili uklanjanja promenljivih)
+	void setPos(int pos);
+
+	// Metod za dobijanje imena dodeljenog registra
+	const std::string& getRegisterName() const;
+
 	// Metod za dobijanje promenljive u formatu stringa
 	std::string get();
 
@@ -52,7 +59,7 @@ public:
 	friend std::ostream& operator<<(std::ostream& out, Variable& var);
 
 	// Prijateljska funkcija za ispisivanje liste promenljivih
-	friend void print(std::list<Variable*>& vars);
+	friend void print(std::list<Variable*>& vars, std::ostream& out);
 
 
 private:
@@ -60,9 +67,7 @@ private:
 	std::string m_name;
 	int m_position;
 	Regs m_assignment;
-
-	// Staticka promenljiva koja broji koliko je kreirano instanci klase
-	static unsigned counter;
+	std::string m_register;
 
 	// Vrednost promenljive
 	int value;
@@ -71,7 +76,7 @@ private:
 	std::string printType();
 
 	// Metod za ispisivanje tabele (trenutnih vrednosti) promenljivih
-	void printTable();
+	void printTable(std::ostream& out);
 
 };
 
@@ -82,6 +87,51 @@ private:
 typedef std::list<Variable*> Variables;
 
 
+/**
+ * Operands of one instruction (destinations, sources, used or defined variables) stored
+ * inline in the instruction. No instruction has more than CAPACITY of them, so filling and
+ * walking operands never touches the heap.
+ */
+class Operands
+{
+public:
+	typedef Variable** iterator;
+	typedef Variable* const* const_iterator;
+
+	static const unsigned int CAPACITY = 3;
+
+	Operands() : m_size(0) {}
+
+	iterator begin() { return m_vars; }
+	iterator end() { return m_vars + m_size; }
+	const_iterator begin() const { return m_vars; }
+	const_iterator end() const { return m_vars + m_size; }
+
+	unsigned int size() const { return m_size; }
+	bool empty() const { return m_size == 0; }
+	Variable*& front() { return m_vars[0]; }
+	Variable*& back() { return m_vars[m_size - 1]; }
+
+	// Dodaje operand (baca izuzetak ako je instrukcija već popunjena)
+	void push_back(Variable* var);
+
+	// Uklanja ponovljene operande, redosled ostalih se ne menja
+	void unique();
+
+	void clear() { m_size = 0; }
+
+private:
+	Variable* m_vars[CAPACITY];
+	unsigned int m_size;
+};
+
+
+/**
+ * Variables live before or after an instruction, ordered by their position.
+ */
+typedef std::vector<Variable*> LiveVariables;
+
+
 /**
  * This class represents one instruction in program code.
  */
@@ -92,24 +142,31 @@ public:
 	//Instruction (int pos, InstructionType type, Variables& dst, Variables& src) :
 	//	m_position(pos), m_type(type), m_dst(dst), m_src(src) {}
 
-	Instruction() : label(nullptr), m_position(counter++), m_type(I_NO_TYPE) {}
+	// Pozicije dodeljuje CompilationContext pri kreiranju
+	Instruction() : label(nullptr), m_position(0), m_type(I_NO_TYPE) {}
 	Instruction(InstructionType type, Variable* lab = nullptr) :
-		label(lab), m_position(counter++), m_type(type) {}
+		label(lab), m_position(0), m_type(type) {}
 
 	// Dodaje labelu kao vezu za instrukciju
 	void addLabel(Variable* lab);
 
+	// Uklanja labelu sa instrukcije
+	void removeLabel();
+
 	// Dodaje destinacionu promenljivu instrukcije
 	void addDst(Variable* var);
 
 	// Dodaje izvorne promenljive instrukcije
 	void addSrc(Variable* var);
 
-	// Dodaje prethodnu instrukciju kao prethodnika
-	void addPred(Instruction* in);
+	// Zamenjuje promenljivu from sa to u odredištima i izvorima instrukcije
+	void replaceVariable(Variable* from, Variable* to);
 
-	// Dodaje sledecu instrukciju kao sledbenika
-	void addSucc(Instruction* in);
+	// Postavlja poziciju instrukcije
+	void setPos(int pos);
+
+	// Vraća poziciju instrukcije
+	int getPos() const;
 
 	// Postavlja da se promenljive koriste
 	void setUse();
@@ -123,32 +180,26 @@ public:
 	// Vraća labelu instrukcije
 	Variable* getLabel() const;
 
+	// Vraća odredišne promenljive instrukcije
+	Operands& getDst();
+
 	// Vraća izvorne promenljive instrukcije
-	Variables& getSrc();
+	Operands& getSrc();
 
-	// Vraća promenljive ulaza instrukcije
-	Variables& getIn();
+	// Vraća promenljive žive nakon instrukcije (uređene po poziciji)
+	LiveVariables& getOut();
 
-	// Vraća promenljive izlaza instrukcije
-	Variables& getOut();
+	// Proverava da li je promenljiva živa nakon instrukcije
+	bool isLiveOut(Variable* var) const;
 
 	// Vraća promenljive definicije instrukcije
-	Variables& getDef();
-
-	// Vraća sledeće instrukcije
-	Variables getSuccIns();
-
-	// Vraća promenljive koje se koriste, ali se ne definišu
-	Variables getUseWithOutWithoutDef();
+	Operands& getDef();
 
-	// Pronalazi instrukciju sa datom labelom
-	friend Instruction* findInstructionWithLabel(Variable* lab, std::list<Instruction*>& ins);
+	// Vraća promenljive koje instrukcija koristi
+	Operands& getUse();
 
-	// Pronalazi instrukciju nakon funkcije
-	friend Instruction* findInstructionAfterFunc(Instruction* in, std::list<Instruction*>& ins);
-
-	// Dodaje vezu između instrukcija
-	friend void addEachother(Instruction& successor, Instruction& predecessor);
+	// Uklanja instrukciju iz liste
+	friend bool removeInstruction(std::list<Instruction*>& ins, std::list<Instruction*>::iterator it);
 
 	// Proverava da li je instrukcija funkcija
 	bool isFunc();
@@ -160,31 +211,25 @@ public:
 	friend std::ostream& operator<<(std::ostream& out, Instruction& in);
 
 	// Ispisuje instrukcije
-	friend void print(std::list<Instruction*>& ins);
+	friend void print(std::list<Instruction*>& ins, std::ostream& out);
 
 
 private:
 	int m_position;
 	InstructionType m_type;
 	
-	Variables m_dst;
-	Variables m_src;
-
-	Variables m_use;
-	Variables m_def;
-	Variables m_in;
-	Variables m_out;
-	std::list<Instruction*> m_succ;
-	std::list<Instruction*> m_pred;
+	Operands m_dst;
+	Operands m_src;
 
-	// Staticki brojač
-	static unsigned counter;
+	Operands m_use;
+	Operands m_def;
+	LiveVariables m_out;        // Ulazne promenljive se ne čuvaju: in = use U (out - def)
 
 	// Pokazivač na labelu
 	Variable* label;
 
 	// Ispisuje tabelu
-	void printTable();
+	void printTable(std::ostream& out);
 
 };
 
@@ -197,9 +242,16 @@ typedef std::list<Instruction*> Instructions;
 // Definisanje tipa Instructions kao list<Instruction*>
 typedef std::list<Instruction*> Instructions;
 
+// Uklanja instrukciju iz liste (memoriju oslobađa arena), a njena labela prelazi na sledeću instrukciju
+// (vraća false i ne menja ništa ako sledeća instrukcija ne postoji ili već ima labelu)
+bool removeInstruction(Instructions& ins, Instructions::iterator it);
+
 // Proverava da li lista vars sadrži var
 bool contains(Variables& vars, Variable* var);
 
+// Proverava da li operandi sadrže var
+bool contains(const Operands& vars, Variable* var);
+
 // Proverava da li lista ins sadrži in
 bool contains(Instructions& ins, Instruction* in);
 
@@ -0,0 +1,102 @@
+#ifndef __IR_ARENA__
+#define __IR_ARENA__
+
+#include "IR.h"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+/**
+ * Bump allocator for objects of one type.
+ *
+ * Objects are constructed one after another in chunks of CHUNK_SIZE, so objects created
+ * together lie next to each other in memory. They are never freed one by one: the pool
+ * destroys all of them and releases the chunks when it is destroyed (for trivially
+ * destructible types without visiting the objects).
+ */
+template <class T>
+class Pool
+{
+public:
+	static const size_t CHUNK_SIZE = 1024;
+
+	Pool() : used(CHUNK_SIZE), count(0) {}
+
+	~Pool()
+	{
+		if (!std::is_trivially_destructible<T>::value)
+			for (size_t c = 0; c < chunks.size(); ++c)
+			{
+				size_t n = c + 1 == chunks.size() ? used : CHUNK_SIZE;
+				for (size_t i = 0; i < n; ++i)
+					chunks[c][i].~T();
+			}
+		for (T* chunk : chunks)
+			::operator delete(chunk);
+	}
+
+	/**
+	 * Constructs a new object in the pool
+	 */
+	template <class... Args>
+	T* create(Args&&... args)
+	{
+		if (used == CHUNK_SIZE)
+		{
+			chunks.push_back(static_cast<T*>(::operator new(CHUNK_SIZE * sizeof(T))));
+			used = 0;
+		}
+		T* object = new (chunks.back() + used) T(std::forward<Args>(args)...);
+		++used;
+		++count;
+		return object;
+	}
+
+	/**
+	 * Returns the number of objects created in the pool
+	 */
+	size_t size() const
+	{
+		return count;
+	}
+
+private:
+	Pool(const Pool&);
+	Pool& operator=(const Pool&);
+
+	std::vector<T*> chunks;
+	size_t used;                // Objects constructed in the last chunk
+	size_t count;
+};
+
+
+/**
+ * Owner of all variables and instructions of one compilation unit. Passes create IR objects
+ * through the arena and only unlink the ones they remove, everything is released at once
+ * together with the arena.
+ */
+class IRArena
+{
+public:
+	template <class... Args>
+	Variable* newVariable(Args&&... args)
+	{
+		return variables.create(std::forward<Args>(args)...);
+	}
+
+	template <class... Args>
+	Instruction* newInstruction(Args&&... args)
+	{
+		return instructions.create(std::forward<Args>(args)...);
+	}
+
+private:
+	Pool<Variable> variables;
+	Pool<Instruction> instructions;
+};
+
+#endif
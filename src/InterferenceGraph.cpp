@@ -0,0 +1,125 @@
+#include "InterferenceGraph.h"
+
+#include <iostream>
+
+InterferenceGraph::InterferenceGraph() : m_size(0), m_edges(0), m_dense(true)
+{
+}
+
+// Računa indeks para čvorova u donjem trouglu matrice (ujedno i ključ grane u heš skupu)
+unsigned long long InterferenceGraph::pairIndex(int x, int y)
+{
+	if (x < y)
+	{
+		int t = x;
+		x = y;
+		y = t;
+	}
+	return (unsigned long long)x * (x - 1) / 2 + y;
+}
+
+// Briše sve grane i postavlja novi broj čvorova
+void InterferenceGraph::reset(int numNodes)
+{
+	m_size = numNodes;
+	m_edges = 0;
+	m_dense = numNodes <= DENSE_INTERFERENCE_LIMIT;
+
+	m_bits.clear();
+	m_edgeSet.clear();
+	if (m_dense)
+		m_bits.assign((pairIndex(numNodes, 0) + 63) / 64, 0);
+
+	m_adjacency.assign(numNodes, std::vector<int>());
+}
+
+// Dodaje granu između dva čvora
+void InterferenceGraph::addEdge(int x, int y)
+{
+	if (x == y)
+		return;
+
+	unsigned long long index = pairIndex(x, y);
+	if (m_dense)
+	{
+		unsigned long long mask = 1ULL << (index & 63);
+		if ((m_bits[index >> 6] & mask) != 0)
+			return;
+		m_bits[index >> 6] |= mask;
+	}
+	else if (!m_edgeSet.insert(index).second)
+	{
+		return;
+	}
+
+	m_adjacency[x].push_back(y);
+	m_adjacency[y].push_back(x);
+	++m_edges;
+}
+
+// Proverava da li dva čvora interferiraju
+bool InterferenceGraph::interferes(int x, int y) const
+{
+	if (x == y)
+		return false;
+
+	unsigned long long index = pairIndex(x, y);
+	if (m_dense)
+		return (m_bits[index >> 6] >> (index & 63) & 1) != 0;
+	return m_edgeSet.count(index) != 0;
+}
+
+// Vraća stepen čvora
+int InterferenceGraph::degree(int x) const
+{
+	return (int)m_adjacency[x].size();
+}
+
+// Vraća susede čvora
+const std::vector<int>& InterferenceGraph::neighbors(int x) const
+{
+	return m_adjacency[x];
+}
+
+// Vraća broj čvorova
+int InterferenceGraph::size() const
+{
+	return m_size;
+}
+
+// Vraća broj grana
+int InterferenceGraph::edgeCount() const
+{
+	return m_edges;
+}
+
+// Proverava da li se koristi matrica bitova
+bool InterferenceGraph::isDense() const
+{
+	return m_dense;
+}
+
+// Ispisuje graf interferencije
+void InterferenceGraph::print(std::ostream& out) const
+{
+	if (m_dense)
+	{
+		for (int j = 0; j < m_size; ++j)
+		{
+			out << "[";
+			for (int i = 0; i < m_size; ++i)
+				out << ' ' << (interferes(j, i) ? __INTERFERENCE__ : __EMPTY__);
+			out << " ]\n";
+		}
+	}
+	else
+	{
+		for (int j = 0; j < m_size; ++j)
+		{
+			out << j << " (" << degree(j) << "):";
+			for (int n : m_adjacency[j])
+				out << ' ' << n;
+			out << '\n';
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#ifndef __INTERFERENCE_GRAPH__
+#define __INTERFERENCE_GRAPH__
+
+#include <iostream>
+#include <vector>
+#include <unordered_set>
+
+#include "Constants.h"
+
+
+/**
+ * Undirected interference graph over register variable positions (Variable::getPos()).
+ *
+ * Every node keeps its neighbours in an adjacency list, so degree queries are O(1) and edge
+ * iteration only touches existing edges. Membership tests (interferes) use a triangular bit
+ * matrix while the graph has at most DENSE_INTERFERENCE_LIMIT nodes, and a hash set of
+ * edges above that, so memory grows with the number of edges instead of N^2.
+ */
+class InterferenceGraph
+{
+public:
+	InterferenceGraph();
+
+	/**
+	 * Removes all edges and resizes the graph
+	 * [in] numNodes - number of nodes (register variables)
+	 */
+	void reset(int numNodes);
+
+	/**
+	 * Adds an edge between two nodes, loops and already existing edges are ignored
+	 */
+	void addEdge(int x, int y);
+
+	/**
+	 * Returns true if there is an edge between the two nodes
+	 */
+	bool interferes(int x, int y) const;
+
+	/**
+	 * Returns the number of neighbours of the node
+	 */
+	int degree(int x) const;
+
+	/**
+	 * Returns the neighbours of the node
+	 */
+	const std::vector<int>& neighbors(int x) const;
+
+	/**
+	 * Returns the number of nodes
+	 */
+	int size() const;
+
+	/**
+	 * Returns the number of edges
+	 */
+	int edgeCount() const;
+
+	/**
+	 * Returns true if membership is kept in the triangular bit matrix
+	 */
+	bool isDense() const;
+
+	/**
+	 * Prints the graph, as a matrix for small graphs and as adjacency lists for large ones
+	 */
+	void print(std::ostream& out) const;
+
+private:
+	/**
+	 * Index of the pair in the lower triangle (x > y) or the key in the edge set
+	 */
+	static unsigned long long pairIndex(int x, int y);
+
+	int m_size;
+	int m_edges;
+	bool m_dense;
+	std::vector<unsigned long long> m_bits;             // Lower triangle of the adjacency matrix, one bit per pair
+	std::unordered_set<unsigned long long> m_edgeSet;   // Edges of large graphs
+	std::vector<std::vector<int>> m_adjacency;          // Neighbours of every node
+};
+
+#endif
@@ -18,41 +18,78 @@ void LexicalAnalysis::initialize()
 
 bool LexicalAnalysis::Do()
 {
+	// a token and its separator usually take at least two characters, and
+	// untouched reserved pages do not cost physical memory
+	tokenList.clear();
+	tokenList.reserve(programLength / 2 + 1);
+
 	while (true)
 	{
-		Token token = getNextTokenLex();
+		Token token = nextToken();
+		tokenList.push_back(token);
 		switch (token.getType())
 		{
 			case T_ERROR:
-				errorToken = token;
-				tokenList.push_back(token);
 				return false;
 			case T_END_OF_FILE:
-				tokenList.push_back(token);
 				return true;
-			case T_WHITE_SPACE:
-				continue;
 			default:
-				tokenList.push_back(token);
 				break;
 		}
 	}
 }
 
 
-bool LexicalAnalysis::readInputFile(string fileName)
+Token LexicalAnalysis::nextToken()
+{
+	Token token = getNextTokenLex();
+	while (token.getType() == T_WHITE_SPACE)
+		token = getNextTokenLex();
+
+	if (token.getType() == T_ERROR)
+		errorToken = token;
+
+	return token;
+}
+
+
+bool LexicalAnalysis::readInputFile(string fileName, bool mapFile)
 {
+	programBuffer.clear();
+	tokenList.clear();
+	nameTable.clear();
+	mappedFile.close();
+	programText = "";
+	programLength = 0;
+
+	if (mapFile && mappedFile.open(fileName))
+	{
+		programText = mappedFile.data();
+		programLength = mappedFile.size();
+		return true;
+	}
+
 	inputFile.open(fileName, ios_base::binary);
 
 	if (!inputFile)
 		return false;
 	
 	inputFile.seekg(0, inputFile.end);
-	int length = (int)inputFile.tellg();
+	streamoff length = inputFile.tellg();
+	// dužina programa se čuva u 32 bita, veći fajl se odbija umesto da se skrati
+	if (length < 0 || (unsigned long long)length > 0xFFFFFFFFull)
+	{
+		inputFile.close();
+		return false;
+	}
 	inputFile.seekg (0, inputFile.beg);
-	programBuffer.resize(length);
+	programBuffer.resize((size_t)length);
 	if (length > 0)
+	{
 		inputFile.read(&programBuffer.front(), length);
+		programText = &programBuffer.front();
+		programLength = (unsigned int)length;
+	}
 	inputFile.close();
 	return true;
 }
@@ -75,15 +112,15 @@ Token LexicalAnalysis::getNextTokenLex()
 		char letter;
 		unsigned int letterIndex = programBufferPosition + counter;
 
-		if (letterIndex < programBuffer.size())
+		if (letterIndex < programLength)
 		{
-			letter = programBuffer[letterIndex];
+			letter = programText[letterIndex];
 		}
 		else
 		{
 			// we have reached the end of input file, force the search letter to invalid value
 			letter = -1;
-			if (programBufferPosition >= programBuffer.size())
+			if (programBufferPosition >= programLength)
 			{
 				// if we have reached end of file and printed out the last correct token
 				// create EOF token and exit
@@ -113,14 +150,15 @@ Token LexicalAnalysis::getNextTokenLex()
 			if (lastFiniteState != IDLE_STATE)
 			{
 				// token recognized, make token
-				token.makeToken(programBufferPosition, lastLetterPos, programBuffer, lastFiniteState);
+				token.makeToken(programBufferPosition, lastLetterPos, programText, lastFiniteState);
+				internName(token);
 				programBufferPosition = lastLetterPos;
 				return token;
 			}
 			else
 			{
 				// error occurred, create error token
-				token.makeErrorToken(programBufferPosition + counter - 1, programBuffer);
+				token.makeErrorToken(programBufferPosition + counter - 1, programText);
 				programBufferPosition = programBufferPosition + counter - 1;
 				return token;
 			}
@@ -135,14 +173,15 @@ Token LexicalAnalysis::getNextTokenLex()
 			if (len > 0)
 			{
 				// token recognized, make token
-				token.makeToken(programBufferPosition, lastLetterPos, programBuffer, lastFiniteState);
+				token.makeToken(programBufferPosition, lastLetterPos, programText, lastFiniteState);
+				internName(token);
 				programBufferPosition = lastLetterPos;
 				return token;
 			}
 			else
 			{
 				// error occurred, create error token
-				token.makeErrorToken(programBufferPosition + counter - 1, programBuffer);
+				token.makeErrorToken(programBufferPosition + counter - 1, programText);
 				programBufferPosition = programBufferPosition + counter - 1;
 				return token;
 			}
@@ -153,25 +192,46 @@ Token LexicalAnalysis::getNextTokenLex()
 }
 
 
+void LexicalAnalysis::internName(Token& token)
+{
+	switch (token.getType())
+	{
+		case T_ID:
+		case T_M_ID:
+		case T_R_ID:
+			token.setNameId(nameTable.intern(token.getValue()));
+			break;
+		default:
+			break;
+	}
+}
+
+
 TokenList& LexicalAnalysis::getTokenList()
 {
 	return tokenList;
 }
 
 
-void LexicalAnalysis::printTokens()
+NameTable& LexicalAnalysis::getNameTable()
+{
+	return nameTable;
+}
+
+
+void LexicalAnalysis::printTokens(ostream& out)
 {
 	if (tokenList.empty())
 	{
-		cout << "Token list is empty!" << endl;
+		out << "Token list is empty!" << endl;
 	}
 	else
 	{
-		printMessageHeader();
+		printMessageHeader(out);
 		TokenList::iterator it = tokenList.begin();
 		for (; it != tokenList.end(); it++)
 		{
-			(*it).printTokenInfo();
+			(*it).printTokenInfo(out);
 		}
 	}
 }
@@ -191,10 +251,10 @@ void LexicalAnalysis::printLexError()
 }
 
 
-void LexicalAnalysis::printMessageHeader()
+void LexicalAnalysis::printMessageHeader(ostream& out)
 {
-	cout << setw(LEFT_ALIGN) << left << "Type:";
-	cout << setw(RIGHT_ALIGN) << right << "Value:" << endl;
-	cout << setfill('-') << setw(LEFT_ALIGN+RIGHT_ALIGN+1) << " " << endl;
-	cout << setfill(' ');
+	out << setw(LEFT_ALIGN) << left << "Type:";
+	out << setw(RIGHT_ALIGN) << right << "Value:" << endl;
+	out << setfill('-') << setw(LEFT_ALIGN+RIGHT_ALIGN+1) << " " << endl;
+	out << setfill(' ');
 }
@@ -7,14 +7,21 @@
 
 #include "Token.h"
 #include "FiniteStateMachine.h"
+#include "MappedFile.h"
+#include "NameTable.h"
 
 
-typedef std::list<Token> TokenList;
+/**
+ * Tokens are stored contiguously, the list is reserved up front from the size of the program
+ */
+typedef std::vector<Token> TokenList;
 
 
 class LexicalAnalysis
 {
 public:
+	LexicalAnalysis() : programText(""), programLength(0), programBufferPosition(0) {}
+
 	/**
 	 * Method for initializing the lexical analysis and FSM
 	 */
@@ -27,8 +34,12 @@ public:
 
 	/**
 	 * Method for reading the input file
+	 * [in] fileName - path of the program source
+	 * [in] mapFile - if true the file is memory mapped read-only and tokens point directly
+	 *		into the mapping, otherwise (or if mapping fails) it is copied into the program buffer
+	 * [out] return - false if the file can't be read or is 4 GB or larger
 	 */
-	bool readInputFile(std::string fileName);
+	bool readInputFile(std::string fileName, bool mapFile = true);
 
 	/**
 	 * Use this function to get next lexical token from program source code.
@@ -37,6 +48,15 @@ public:
 	 */
 	Token getNextTokenLex();
 
+	/**
+	 * Use this function to pull the next significant token (white space is skipped).
+	 * It is used both to fill the token list and by the parser in streaming mode,
+	 * where the token list is never built.
+	 *
+	 * @return next non white space token, remembers it as error token if it is T_ERROR
+	 */
+	Token nextToken();
+
 	/**
 	 * Use this function to get the list of tokens read from the source code
 	 *
@@ -44,11 +64,18 @@ public:
 	 */
 	TokenList& getTokenList();
 
+	/**
+	 * Use this function to get the table of identifier names interned while lexing
+	 *
+	 * @return name table
+	 */
+	NameTable& getNameTable();
+
 	/**
 	 * Prints the token list
 	 *
 	 */
-	void printTokens();
+	void printTokens(std::ostream& out = std::cout);
 
 	/**
 	 * Prints the errornous token if present
@@ -63,10 +90,26 @@ private:
 	std::ifstream inputFile;
 
 	/**
-	 * Program buffer containing the contents of the input files
+	 * Program buffer containing the contents of the input files, used when the file is not mapped
 	 */
 	std::vector<char> programBuffer;
 
+	/**
+	 * Read-only mapping of the input file
+	 */
+	MappedFile mappedFile;
+
+	/**
+	 * Program text which is being analyzed, points either into mappedFile or programBuffer.
+	 * Token values are views into it, so it must outlive the token list.
+	 */
+	const char* programText;
+
+	/**
+	 * Number of characters in the program text
+	 */
+	unsigned int programLength;
+
 	/**
 	 * Current position of the program buffer
 	 */
@@ -82,15 +125,25 @@ private:
 	 */
 	TokenList tokenList;
 
+	/**
+	 * Interned names of all identifier tokens
+	 */
+	NameTable nameTable;
+
 	/**
 	 * IF an error occurs while parsing this attribute will hold the errornous Token
 	 */
 	Token errorToken;
 
+	/**
+	 * Interns the name of an identifier token and stores its id in the token
+	 */
+	void internName(Token& token);
+
 	/**
 	 * Used for printing the test list. It decorates the output with header naming the columns
 	 */
-	void printMessageHeader();
+	void printMessageHeader(std::ostream& out = std::cout);
 };
 
 #endif
@@ -0,0 +1,115 @@
+#include "LinearScan.h"
+
+#include <algorithm>
+
+LinearScan::LinearScan(int numNodes, int numRegs) :
+	m_numRegs(numRegs), m_start(numNodes, -1), m_end(numNodes, -1), m_unspillable(numNodes, false),
+	m_costs(numNodes, 1.0), m_active(), m_free(), m_colors(numNodes, 0), m_spilled()
+{
+}
+
+// Postavlja interval života čvora
+void LinearScan::setInterval(int node, int start, int end)
+{
+	m_start[node] = start;
+	m_end[node] = end;
+}
+
+// Označava čvor koji ne sme biti prosut
+void LinearScan::setUnspillable(int node)
+{
+	m_unspillable[node] = true;
+}
+
+// Postavlja cenu prosipanja čvorova
+void LinearScan::setSpillCosts(const std::vector<double>& costs)
+{
+	m_costs = costs;
+}
+
+// Dodeljuje registre intervalima redom po početku
+bool LinearScan::allocate()
+{
+	std::vector<int> order;
+	for (int n = 0; n < (int)m_start.size(); ++n)
+		if (m_start[n] != -1)
+			order.push_back(n);
+	std::sort(order.begin(), order.end(), [this](int a, int b)
+	{
+		return m_start[a] != m_start[b] ? m_start[a] < m_start[b] : a < b;
+	});
+
+	m_active.clear();
+	m_free.clear();
+	for (int r = 1; r <= m_numRegs; ++r)
+		m_free.insert(r);
+
+	for (int node : order)
+	{
+		expire(m_start[node]);
+
+		if (m_free.empty())
+		{
+			// aktivni interval najmanje cene po instrukciji, a sme da se prosipa (kod jednake cene
+			// onaj koji se kasnije završava)
+			int victim = -1;
+			for (std::set<std::pair<int, int>>::reverse_iterator it = m_active.rbegin(); it != m_active.rend(); ++it)
+				if (!m_unspillable[it->second] && (victim == -1 || spillWeight(it->second) < spillWeight(victim)))
+					victim = it->second;
+
+			if (victim != -1 && (m_unspillable[node] || spillWeight(victim) < spillWeight(node) ||
+				(spillWeight(victim) == spillWeight(node) && m_end[victim] > m_end[node])))
+			{
+				spill(victim);
+			}
+			else
+			{
+				m_spilled.push_back(node);
+				continue;
+			}
+		}
+
+		m_colors[node] = *m_free.begin();
+		m_free.erase(m_free.begin());
+		m_active.insert(std::make_pair(m_end[node], node));
+	}
+
+	return m_spilled.empty();
+}
+
+// Vraća boju čvora
+int LinearScan::getColor(int node) const
+{
+	return m_colors[node];
+}
+
+// Vraća čvorove koji nisu dobili registar
+const std::vector<int>& LinearScan::getSpilled() const
+{
+	return m_spilled;
+}
+
+// Oslobađa registre intervala koji su se završili pre date pozicije
+void LinearScan::expire(int position)
+{
+	while (!m_active.empty() && m_active.begin()->first < position)
+	{
+		m_free.insert(m_colors[m_active.begin()->second]);
+		m_active.erase(m_active.begin());
+	}
+}
+
+// Vraća cenu prosipanja čvora po instrukciji njegovog intervala
+double LinearScan::spillWeight(int node) const
+{
+	return m_costs[node] / (m_end[node] - m_start[node] + 1);
+}
+
+// Prosipa čvor i oslobađa njegov registar
+void LinearScan::spill(int node)
+{
+	m_active.erase(std::make_pair(m_end[node], node));
+	m_free.insert(m_colors[node]);
+	m_colors[node] = 0;
+	m_spilled.push_back(node);
+}
@@ -0,0 +1,90 @@
+#ifndef __LINEAR_SCAN__
+#define __LINEAR_SCAN__
+
+#include <set>
+#include <utility>
+#include <vector>
+
+
+/**
+ * Linear scan register allocator (Poletto-Sarkar).
+ *
+ * Every node has one live interval [start, end] over the instruction numbering. Intervals are
+ * visited once in order of their start; intervals which ended before the current start give
+ * their register back. When no register is free, the interval with the lowest spill cost per
+ * instruction it spans is spilled among the active ones and the current one (on a tie the one
+ * ending last), so variables used in loops keep their registers.
+ * The whole allocation is O(n (log n + K)) in the number of intervals and K registers and
+ * needs no interference graph.
+ */
+class LinearScan
+{
+public:
+	/**
+	 * [in] numNodes - number of nodes (variable positions)
+	 * [in] numRegs  - number of registers (colors 1..numRegs)
+	 */
+	LinearScan(int numNodes, int numRegs);
+
+	/**
+	 * Sets the live interval of the node, nodes without an interval don't get a register
+	 */
+	void setInterval(int node, int start, int end);
+
+	/**
+	 * Marks the node as one which must get a register
+	 */
+	void setUnspillable(int node);
+
+	/**
+	 * Sets spill cost of every node, nodes with a higher cost per instruction of their interval
+	 * are spilled later. Without costs every node costs 1.
+	 */
+	void setSpillCosts(const std::vector<double>& costs);
+
+	/**
+	 * Runs the sweep
+	 * [out] return - true if every node with an interval got a color, false if some have to be spilled
+	 */
+	bool allocate();
+
+	/**
+	 * Returns the color (1..numRegs) of the node, 0 if the node was spilled
+	 */
+	int getColor(int node) const;
+
+	/**
+	 * Returns the nodes which did not get a color
+	 */
+	const std::vector<int>& getSpilled() const;
+
+private:
+	/**
+	 * Gives back the registers of active intervals which end before the position
+	 */
+	void expire(int position);
+
+	/**
+	 * Spills the node and frees its register
+	 */
+	void spill(int node);
+
+	/**
+	 * Returns the spill cost of the node per instruction of its interval
+	 */
+	double spillWeight(int node) const;
+
+	int m_numRegs;
+	std::vector<int> m_start;               // -1 for nodes without an interval
+	std::vector<int> m_end;
+	std::vector<bool> m_unspillable;
+	std::vector<double> m_costs;
+
+	std::set<std::pair<int, int>> m_active; // (end, node) of intervals holding a register
+	std::set<int> m_free;                   // Free registers, the lowest is used first
+
+	std::vector<int> m_colors;
+	std::vector<int> m_spilled;
+};
+
+#endif
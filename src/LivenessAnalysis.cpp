@@ -1,259 +1,611 @@
 ﻿/* Autor: Kristina Mladenović Datum: 05.06.2024. */
 
 #include "LivenessAnalysis.h"
+#include "Dump.h"
+#include "Emitter.h"
+#include "TimeReport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <unordered_map>
 
 // Konstruktor klase LivenessAnalysis. Inicijalizuje analizu na osnovu sintaksnog stabla
-LivenessAnalysis::LivenessAnalysis(SyntaxAnalysis& syntax) :
-	err(false), reg_vars(syntax.getRegs()), mem_vars(syntax.getMem()),
+LivenessAnalysis::LivenessAnalysis(SyntaxAnalysis& syntax, const Target& target, RegAllocType allocator) :
+	syntax(syntax), target(target), allocator(allocator), dump(syntax.getContext().getDump()),
+	report(syntax.getContext().getTimeReport()), err(false), reg_vars(syntax.getRegs()), mem_vars(syntax.getMem()),
 	instrs(syntax.getInstructions()), interferenceGraph()
 {
-	setPredAndSucc();
 	setUseAndDef();
-	for (int j = 0; j < (int)reg_vars.size(); ++j)
-	{
-		interferenceGraph.push_back({});
-		for (int i = 0; i < (int)reg_vars.size(); ++i)
-			interferenceGraph[j].push_back(0);
-	}
 }
 
-//Izvršava analizu
+// Izvršava analizu. Dok god bojenje ne uspe, promenljive koje nisu obojene se prosipaju u
+// memoriju, a analiza se ponavlja nad izmenjenim kodom.
 bool LivenessAnalysis::Do()
 {
-	liveness();
-	setGraph();
-	resourceAllocation();
+	renumber();
+	while (true)
+	{
+		{
+			TimeReport::Scope scope(report, "cfg");
+			cfg.build(instrs);
+			cfg.computeLoops();
+		}
+		if (dump.enabled(DUMP_CFG))
+			cfg.print(dump.stream());
+
+		ConstantPropagation constants(syntax, cfg, (int)reg_vars.size());
+		bool folded;
+		{
+			TimeReport::Scope scope(report, "constant propagation");
+			folded = constants.Do();
+		}
+		if (folded)
+		{
+			renumber();
+			setUseAndDef();
+			continue;
+		}
+
+		{
+			TimeReport::Scope scope(report, "liveness");
+			liveness();
+		}
+		bool removed;
+		{
+			TimeReport::Scope scope(report, "dead code");
+			removed = removeDeadCode();
+		}
+		if (removed)
+		{
+			renumber();
+			setUseAndDef();
+			continue;
+		}
+
+		// nakon prosipanja se ne izvlači, kako se opseg privremenih promenljivih ne bi produžio
+		LoopInvariantMotion invariants(syntax, cfg);
+		bool hoisted = false;
+		if (spillTemps.empty())
+		{
+			TimeReport::Scope scope(report, "loop invariant motion");
+			hoisted = invariants.Do();
+		}
+		if (hoisted)
+		{
+			renumber();
+			setUseAndDef();
+			continue;
+		}
+
+		std::vector<int> spilled;
+		if (allocator == RA_LINEAR_SCAN)
+		{
+			TimeReport::Scope scope(report, "linear scan");
+			spilled = linearScan();
+		}
+		else
+		{
+			bool coalesced;
+			{
+				TimeReport::Scope scope(report, "graph build");
+				setGraph();
+			}
+			{
+				TimeReport::Scope scope(report, "coalesce");
+				coalesced = coalesce();
+			}
+			if (coalesced)
+			{
+				renumber();
+				setUseAndDef();
+				continue;
+			}
+			spilled = resourceAllocation();
+		}
+		if (spilled.empty())
+			break;
+
+		for (int node : spilled)
+			if (spillTemps.count(regsByPos[node]) != 0)
+			{
+				err = true;
+				std::cerr << "Not enough registers to hold the spilled variables!" << std::endl;
+				return false;
+			}
+
+		TimeReport::Scope scope(report, "spill");
+		std::vector<Variable*> vars;
+		for (int node : spilled)
+			vars.push_back(regsByPos[node]);
+		for (Variable* v : vars)
+			spill(v);
+
+		renumber();
+		setUseAndDef();
+	}
 
 	return !err;
 }
 
-// Implementacija algoritma iterativnog računanja živosti instrukcija.
+// Računanje živosti promenljivih nad osnovnim blokovima i skupovima bitova (indeksiranim sa
+// Variable::getPos()). Gen/kill skupovi blokova se računaju jednom, jednačine se rešavaju preko
+// radne liste koja se početno puni u postorderu grafa (sledbenici pre prethodnika), a prethodnici
+// se vraćaju u listu samo kada se ulazni skup bloka promeni, sve do prave fiksne tačke.
+// Na kraju se živost svake instrukcije dobija jednim prolazom unazad kroz njen blok.
 void LivenessAnalysis::liveness()
 {
-	bool prevGood = true;
-	bool done = false;
+	int numVars = (int)reg_vars.size();
+	cfg.computeLocalSets(numVars);
+
+	std::vector<BasicBlock*> order = cfg.postorder();
+	std::deque<BasicBlock*> worklist(order.begin(), order.end());
+	std::vector<bool> queued(order.size(), true);
+	BitSet newIn(numVars);
+	int steps = 0;
 
-	for (int counter = 0; !done && counter < 10; ++counter)
+	while (!worklist.empty())
 	{
-		for (Instructions::reverse_iterator rit = instrs.rbegin(); rit != instrs.rend(); ++rit)
+		BasicBlock* b = worklist.front();
+		worklist.pop_front();
+		queued[b->getId()] = false;
+		++steps;
+
+		// out[b] = unija in[s] svih sledbenika s
+		BitSet& out = b->getOut();
+		out.clear();
+		for (BasicBlock* s : b->getSucc())
+			out.unionWith(s->getIn());
+
+		// in[b] = use[b] U (out[b] - def[b])
+		newIn = out;
+		newIn.subtract(b->getDef());
+		newIn.unionWith(b->getUse());
+
+		if (newIn != b->getIn())
 		{
-			Instruction& curr = **rit;
-			Variables savedIn = curr.getIn();
-			Variables savedOut = curr.getOut();
+			b->getIn().swap(newIn);
+			for (BasicBlock* p : b->getPred())
+				if (!queued[p->getId()])
+				{
+					queued[p->getId()] = true;
+					worklist.push_back(p);
+				}
+		}
+	}
 
-			Variables& in = curr.getIn();
-			Variables& out = curr.getOut();
+	// živost pojedinačnih instrukcija, jednim prolazom unazad kroz svaki blok
+	regsByPos.assign(numVars, nullptr);
+	for (Variable* v : reg_vars)
+		regsByPos[v->getPos()] = v;
 
-			out.clear();
-			out = curr.getSuccIns();
+	BitSet live(numVars);
+	for (BasicBlock* b : cfg.getBlocks())
+	{
+		live = b->getOut();
+		std::vector<Instruction*>& code = b->getInstructions();
+		for (std::vector<Instruction*>::reverse_iterator it = code.rbegin(); it != code.rend(); ++it)
+		{
+			Instruction& curr = **it;
+			// vektor zadržava kapacitet iz prethodne iteracije analize
+			LiveVariables& outVars = curr.getOut();
+			outVars.clear();
+			for (int v = live.findNext(0); v != -1; v = live.findNext(v + 1))
+				outVars.push_back(regsByPos[v]);
+
+			for (Variable* v : curr.getDef())
+				live.reset(v->getPos());
+			for (Variable* v : curr.getUse())
+				live.set(v->getPos());
+		}
+	}
 
-			in.clear();
-			in = curr.getUseWithOutWithoutDef();
+	if (dump.enabled(DUMP_LIVENESS))
+	{
+		dump.stream() << ">>>>>=====-----\n"
+			<< "| Liveness (fixpoint after " << steps << " block visits):\n"
+			<< ">>>>>=====-----\n";
+		print(instrs, dump.stream());
+	}
+}
 
-			if (prevGood)
-				if (savedIn != in || savedOut != out)
-				{
-					prevGood = false;
-				}
+// Uklanja nedostižne blokove i instrukcije čije definisane promenljive nisu žive nakon njih.
+bool LivenessAnalysis::removeDeadCode()
+{
+	std::unordered_set<Instruction*> unreachable;
+	for (BasicBlock* b : cfg.getBlocks())
+		if (b->getIdom() == nullptr)
+			unreachable.insert(b->getInstructions().begin(), b->getInstructions().end());
+
+	int deadCount = 0;
+	int unreachableCount = 0;
+	for (Instructions::iterator it = instrs.begin(); it != instrs.end();)
+	{
+		Instruction* in = *it;
+
+		// labele nedostižnog koda mogu biti cilj samo skokova iz nedostižnog koda
+		if (unreachable.count(in) != 0)
+		{
+			it = instrs.erase(it);
+			++unreachableCount;
+			continue;
 		}
-		done = prevGood;
-		prevGood = true;
-		std::cout << ">>>>>=====-----\n"
-			<< "| Iteration " << counter + 1 << ":\n"
-			<< ">>>>>=====-----\n";
-		print(instrs);
+
+		bool dead = !in->getDef().empty() && in->getType() != I_SW && !isBranch(in->getType());
+		for (Variable* v : in->getDef())
+			if (in->isLiveOut(v))
+				dead = false;
+
+		Instructions::iterator next = it;
+		++next;
+		if (dead)
+		{
+			// labela ne može preći na sledeću instrukciju koja već ima svoju, pa ostaje na nop
+			if (!removeInstruction(instrs, it))
+			{
+				Instruction* nop = syntax.getContext().newInstruction(I_NOP);
+				nop->addLabel(in->getLabel());
+				*it = nop;
+			}
+			++deadCount;
+		}
+		it = next;
 	}
+
+	if (deadCount + unreachableCount == 0)
+		return false;
+	if (dump.enabled(DUMP_PASSES))
+		dump.stream() << "Removed " << deadCount << " dead and " << unreachableCount << " unreachable instructions" << std::endl;
+	return true;
 }
 
-// Formiranje grafa interferencije izlaznih varijabli instrukcija.
+// Formiranje grafa interferencije izlaznih varijabli instrukcija. Grane dobija svaka definicija,
+// i ona koja nije živa nakon instrukcije, jer svejedno upisuje u svoj registar.
 void LivenessAnalysis::setGraph()
 {
+	findZeroRegisters();
+	interferenceGraph.reset((int)reg_vars.size());
+
 	for (Instructions::iterator it = instrs.begin(); it != instrs.end(); ++it)
 	{
 		Instruction& i = **it;
-		Variables& out = i.getOut();
-		Variables& def = i.getDef();
-		for (Variables::iterator it = def.begin(); it != def.end(); ++it)
-		{
-			Variable* definedVar = *it;
-			if (contains(out, definedVar))
-				for (Variable* v : out)
-					if (v != definedVar)
-						setInterference(v->getPos(), definedVar->getPos());
-		}
+		LiveVariables& out = i.getOut();
+		Variable* copied = copySource(&i);
+		for (Variable* definedVar : i.getDef())
+			for (Variable* v : out)
+				if (v != definedVar && v != copied)
+					setInterference(v->getPos(), definedVar->getPos());
 	}
 }
 
-// Izvršava alociranje resursa (registara).
-void LivenessAnalysis::resourceAllocation()
+// Spaja promenljive povezane kopijama koje ne interferiraju (Briggs/George) i briše kopije.
+// U jednom prolazu se svaka promenljiva spaja najviše jednom, a ostale kopije čekaju sledeći
+// prolaz nad ponovo izračunatim grafom.
+bool LivenessAnalysis::coalesce()
 {
-	std::stack<Variable*> simplificationStack = createSimplificationStack();
+	int k = target.getRegisterCount();
+	bool changed = false;
+	std::vector<bool> touched(reg_vars.size(), false);
+	std::vector<Instructions::iterator> copies;
+	// rename[pos] je promenljiva u koju je spojena promenljiva na poziciji pos (nullptr ako nije)
+	std::vector<Variable*> rename(reg_vars.size(), nullptr);
+	int merged = 0;
 
-	Variable* in_use;
-	Variable* prev = nullptr;
+	for (Instructions::iterator it = instrs.begin(); it != instrs.end(); ++it)
+	{
+		Variable* y = copySource(*it);
+		if (y == nullptr)
+			continue;
+		Variable* x = (*it)->getDst().front();
 
-	while (!simplificationStack.empty()) {
-		in_use = simplificationStack.top();
-		simplificationStack.pop();
+		// kopija same sebe (npr. ostala nakon ranijeg spajanja) se samo briše
+		if (x == y)
+		{
+			copies.push_back(it);
+			continue;
+		}
 
-		vars.push_back(in_use);
+		if (spillTemps.count(x) != 0 || spillTemps.count(y) != 0)
+			continue;
+		int a = x->getPos();
+		int b = y->getPos();
+		if (touched[a] || touched[b] || interferenceGraph.interferes(a, b))
+			continue;
+		if (!briggsTest(a, b, k) && !georgeTest(a, b, k))
+			continue;
 
-		if (prev == nullptr) {
-			int counter = 1;
-			in_use->getAssignment() = (Regs)counter;
-		}
-		else {
-			int color = getColor(in_use);
-			if (color == -1) {
-				err = true;
-				return;
-			}
-			else {
-				in_use->getAssignment() = (Regs)color;
-			}
+		touched[a] = touched[b] = true;
+		rename[b] = x;
+		++merged;
+		copies.push_back(it);
+		if (dump.enabled(DUMP_PASSES))
+			dump.stream() << "Coalesced " << y->getName() << " into " << x->getName() << std::endl;
+	}
+
+	if (merged != 0)
+	{
+		// svi operandi se preimenuju u jednom prolazu, prateći lanac spajanja do predstavnika
+		auto find = [&rename](Variable* v)
+		{
+			while (v->getType() == Variable::REG_VAR && rename[v->getPos()] != nullptr)
+				v = rename[v->getPos()];
+			return v;
+		};
+		for (Instruction* in : instrs)
+		{
+			for (Variable*& v : in->getDst())
+				v = find(v);
+			for (Variable*& v : in->getSrc())
+				v = find(v);
 		}
-		prev = in_use;
 	}
-}
 
+	for (Instructions::iterator it : copies)
+		if (removeInstruction(instrs, it))
+			changed = true;
+	reg_vars.remove_if([this, &rename](Variable* v)
+	{
+		if (rename[v->getPos()] == nullptr)
+			return false;
+		zeroRegs.erase(v);
+		return true;
+	});
+	return changed || merged != 0;
+}
 
-// Uklanja element iz matrice na određenoj poziciji.
-void removeElementOfMatrix(int element, std::vector<std::vector<int>>& matrix)
+// Briggs: spojeni čvor ima manje od k suseda značajnog stepena
+bool LivenessAnalysis::briggsTest(int x, int y, int k)
 {
-	std::vector<std::vector<int>>::iterator mit = matrix.begin();
-	for (int i = 0; i < element; ++i)
-		++mit;
-	matrix.erase(mit);
+	std::unordered_set<int> merged(interferenceGraph.neighbors(x).begin(), interferenceGraph.neighbors(x).end());
+	merged.insert(interferenceGraph.neighbors(y).begin(), interferenceGraph.neighbors(y).end());
 
-	std::vector<int>::iterator mmit;
-	for (mit = matrix.begin(); mit != matrix.end(); ++mit)
+	int significant = 0;
+	for (int t : merged)
 	{
-		mmit = mit->begin();
-		for (int i = 0; i < element; ++i)
-			++mmit;
-		mit->erase(mmit);
+		// sused oba čvora nakon spajanja gubi jednu granu
+		int degree = interferenceGraph.degree(t);
+		if (interferenceGraph.interferes(t, x) && interferenceGraph.interferes(t, y))
+			--degree;
+		if (degree >= k && ++significant >= k)
+			return false;
 	}
+	return true;
 }
 
-// Pronalazi element sa najvećim rangu u matrici.
-int findElementWithHighestRang(std::vector<std::vector<int>>& matrix)
+// George: svaki sused od y već interferira sa x ili je malog stepena
+bool LivenessAnalysis::georgeTest(int x, int y, int k)
 {
-	std::vector<int> count;
-	int size = (int)matrix.size();
-	for (int i = 0; i < size; ++i)
-		count.push_back(0);
-
-	for (int i = 0; i < size; ++i)
-		for (int j = 0; j < i; ++j)
-			if (matrix[j][i] == 1)
-			{
-				count[i]++;
-				count[j]++;
-			}
+	for (int t : interferenceGraph.neighbors(y))
+		if (!interferenceGraph.interferes(t, x) && interferenceGraph.degree(t) >= k)
+			return false;
+	return true;
+}
+
+// Vraća izvor kopije registra ili nullptr ako instrukcija nije kopija
+Variable* LivenessAnalysis::copySource(Instruction* in)
+{
+	Operands& src = in->getSrc();
+	if (in->getDst().size() != 1 || src.size() != 2)
+		return nullptr;
+	Variable* a = src.front();
+	Variable* b = src.back();
+
+	switch (in->getType())
+	{
+	case I_ADDI:
+		return b->getValue() == 0 ? a : nullptr;
+	case I_ADD:
+	case I_OR:
+		if (zeroRegs.count(a) != 0)
+			return b;
+		return zeroRegs.count(b) != 0 ? a : nullptr;
+	case I_SUB:
+		return zeroRegs.count(b) != 0 ? a : nullptr;
+	default:
+		return nullptr;
+	}
+}
 
-	int max = -1;
-	for (int i = 0; i < size; ++i)
-		if (count[i] < __REG_NUMBER__)
+// Pronalazi registarske promenljive čija je jedina definicija li r, 0
+void LivenessAnalysis::findZeroRegisters()
+{
+	std::unordered_map<Variable*, int> defs;
+	zeroRegs.clear();
+	for (Instruction* i : instrs)
+		for (Variable* v : i->getDef())
 		{
-			max = i;
-			continue;
+			++defs[v];
+			if (i->getType() == I_LI && i->getSrc().front()->getValue() == 0)
+				zeroRegs.insert(v);
 		}
-	if (max == -1)
-		throw std::runtime_error("Not enough registers!");
+	for (std::unordered_map<Variable*, int>::iterator it = defs.begin(); it != defs.end(); ++it)
+		if (it->second > 1)
+			zeroRegs.erase(it->first);
+}
 
-	for (int i = 0; i < size; ++i)
-		if (count[max] < count[i] && count[i] < __REG_NUMBER__)
-			max = i;
+// Izvršava alociranje resursa (registara) bojenjem grafa interferencije (Chaitin-Briggs).
+// Vraća pozicije promenljivih koje je potrebno prosuti.
+std::vector<int> LivenessAnalysis::resourceAllocation()
+{
+	GraphColoring coloring(interferenceGraph, target.getRegisterCount());
+	coloring.setSpillCosts(spillCosts());
 
-	return max;
+	{
+		TimeReport::Scope scope(report, "simplify");
+		coloring.simplify();
+	}
+	{
+		TimeReport::Scope scope(report, "select");
+		coloring.select();
+	}
+	if (!coloring.getSpilled().empty())
+		return coloring.getSpilled();
+
+	for (Variable* v : reg_vars)
+	{
+		Regs reg = coloring.getColor(v->getPos());
+		v->assign(reg, target.getRegisterName(reg));
+	}
+	return std::vector<int>();
 }
 
-// Kreira stek simplifikacije na osnovu grafa interferencije.
-std::stack<Variable*> LivenessAnalysis::createSimplificationStack()
+// Alocira registre linearnim skeniranjem. Interval promenljive obuhvata sve tačke u kojima je
+// živa: upotreba u instrukciji p je tačka 2p, definicija 2p + 1, pa se registar promenljive koja
+// se poslednji put koristi u p može dodeliti promenljivoj koja se u p definiše.
+std::vector<int> LivenessAnalysis::linearScan()
 {
-	std::stack<Variable*> result;
-
-	Matrix matrixToWorkOn = interferenceGraph;
-	Variables notYetTaken = reg_vars;
-	Variables::iterator found;
+	int numVars = (int)reg_vars.size();
+	std::vector<int> start(numVars, std::numeric_limits<int>::max());
+	std::vector<int> end(numVars, -1);
+	auto extend = [&start, &end](int v, int point)
+	{
+		start[v] = std::min(start[v], point);
+		end[v] = std::max(end[v], point);
+	};
 
-	int curr;
-	for (int i = 0; i < (int)interferenceGraph.size(); ++i)
+	for (BasicBlock* b : cfg.getBlocks())
 	{
-		curr = findElementWithHighestRang(matrixToWorkOn);
-		removeElementOfMatrix(curr, matrixToWorkOn);
+		std::vector<Instruction*>& code = b->getInstructions();
+		if (code.empty())
+			continue;
 
-		found = notYetTaken.begin();
-		for (int j = 0; j < curr; ++j)
-			++found;
+		int first = 2 * code.front()->getPos();
+		int last = 2 * code.back()->getPos() + 1;
+		for (int v = b->getIn().findNext(0); v != -1; v = b->getIn().findNext(v + 1))
+			extend(v, first);
+		for (int v = b->getOut().findNext(0); v != -1; v = b->getOut().findNext(v + 1))
+			extend(v, last);
 
-		result.push(*found);
-		notYetTaken.erase(found);
+		for (Instruction* i : code)
+		{
+			for (Variable* v : i->getUse())
+				extend(v->getPos(), 2 * i->getPos());
+			for (Variable* v : i->getDef())
+				extend(v->getPos(), 2 * i->getPos() + 1);
+		}
 	}
 
-	return result;
-}
+	LinearScan scan(numVars, target.getRegisterCount());
+	for (int v = 0; v < numVars; ++v)
+		if (end[v] != -1)
+			scan.setInterval(v, start[v], end[v]);
+	for (Variable* v : spillTemps)
+		scan.setUnspillable(v->getPos());
+	scan.setSpillCosts(spillCosts());
 
-// Dodeljuje boje (registre) varijablama na osnovu graf bojenja.
-int LivenessAnalysis::getColor(Variable* var) {
-	std::list<int> allReg;
-	for (int i = 1; i <= __REG_NUMBER__; ++i)
-		allReg.push_back(i);
+	if (!scan.allocate())
+		return scan.getSpilled();
 
-	for (Variable* other : vars)
-		if (interferenceGraph[var->getPos()][other->getPos()] == 1)
-			allReg.remove((int)other->getAssignment());
+	for (Variable* v : reg_vars)
+	{
+		Regs reg = scan.getColor(v->getPos());
+		v->assign(reg, reg == no_assign ? "" : target.getRegisterName(reg));
+	}
+	return std::vector<int>();
+}
 
-	if (allReg.empty())
-		return -1;
-	else
-		return allReg.front();
+// Računa cenu prosipanja svake registarske promenljive kao broj njenih korišćenja i definicija,
+// gde se svako pojavljivanje unutar petlje množi sa 10 za svaki nivo ugnežđenosti.
+std::vector<double> LivenessAnalysis::spillCosts()
+{
+	std::vector<double> costs(reg_vars.size(), 0.0);
+	for (BasicBlock* b : cfg.getBlocks())
+	{
+		double weight = std::pow(10.0, std::min(b->getLoopDepth(), 8));
+		for (Instruction* i : b->getInstructions())
+		{
+			for (Variable* v : i->getUse())
+				costs[v->getPos()] += weight;
+			for (Variable* v : i->getDef())
+				costs[v->getPos()] += weight;
+		}
+	}
+	for (Variable* v : spillTemps)
+		costs[v->getPos()] = std::numeric_limits<double>::infinity();
+	return costs;
 }
 
-// Postavlja prethodnike i sledbenike instrukcija.
-void LivenessAnalysis::setPredAndSucc()
+// Prosipa promenljivu u novu memorijsku lokaciju. Pre svake upotrebe se vrednost učitava
+// (la t, slot; lw t, 0(t)), a nakon svake definicije upisuje (la a, slot; sw t, 0(a)).
+void LivenessAnalysis::spill(Variable* var)
 {
-	Instructions::iterator currentInstruction = instrs.begin();
-	Instructions::iterator prevInstruction = currentInstruction++;
+	Variable* slot = syntax.getContext().newVariable(Variable::MEM_VAR, "_spill_" + var->getName(), 0);
+	mem_vars.push_back(slot);
+	Variable* zero = syntax.constVariable(0);
 
-	Instruction* labeledInstruction;
-	bool shouldAddToNext = true; 
-	while (currentInstruction != instrs.end())
+	for (Instructions::iterator it = instrs.begin(); it != instrs.end(); ++it)
 	{
-		Instruction& curr = **currentInstruction;
-		Instruction& prev = **prevInstruction;
+		Instruction* in = *it;
+		bool used = contains(in->getSrc(), var);
+		bool defined = contains(in->getDst(), var);
+		if (!used && !defined)
+			continue;
 
-		if (!prev.isFunc() && shouldAddToNext)
+		Variable* temp = createSpillTemp(var);
+		in->replaceVariable(var, temp);
+
+		if (used)
 		{
-			addEachother(curr, prev);
+			Instruction* address = syntax.getContext().newInstruction(I_LA);
+			address->addDst(temp);
+			address->addSrc(slot);
+			Instruction* load = syntax.getContext().newInstruction(I_LW);
+			load->addDst(temp);
+			load->addSrc(zero);
+			load->addSrc(temp);
+
+			// labela prelazi na prvu umetnutu instrukciju kako bi skokovi izvršili i učitavanje
+			if (in->getLabel() != nullptr)
+			{
+				address->addLabel(in->getLabel());
+				in->removeLabel();
+			}
+			instrs.insert(it, address);
+			instrs.insert(it, load);
 		}
-		if (!shouldAddToNext)
-			shouldAddToNext = true;
 
-		switch (curr.getType())
+		if (defined)
 		{
-		case I_B:
-			shouldAddToNext = false;
-			labeledInstruction = findInstructionWithLabel(curr.getSrc().back(), instrs);
-			if (labeledInstruction->isFunc())
-				labeledInstruction = findInstructionAfterFunc(labeledInstruction, instrs);
-			if (labeledInstruction != nullptr)
-				addEachother(*labeledInstruction, curr);
-			break;
-		case I_BLTZ:
-			labeledInstruction = findInstructionWithLabel(curr.getSrc().back(), instrs);
-			if (labeledInstruction->isFunc())
-				labeledInstruction = findInstructionAfterFunc(labeledInstruction, instrs);
-			if (labeledInstruction != nullptr)
-				addEachother(*labeledInstruction, curr);
-		
+			Variable* base = createSpillTemp(var);
+			Instruction* address = syntax.getContext().newInstruction(I_LA);
+			address->addDst(base);
+			address->addSrc(slot);
+			Instruction* store = syntax.getContext().newInstruction(I_SW);
+			store->addSrc(temp);
+			store->addSrc(zero);
+			store->addSrc(base);
+
+			Instructions::iterator next = it;
+			++next;
+			instrs.insert(next, address);
+			it = instrs.insert(next, store);
 		}
-		prevInstruction = currentInstruction;
-		++currentInstruction;
-		if (currentInstruction != instrs.end())
-			if ((*currentInstruction)->isFunc())
-				++currentInstruction;
 	}
+
+	if (dump.enabled(DUMP_PASSES))
+		dump.stream() << "Spilled " << var->getName() << " to " << slot->getName() << std::endl;
+	reg_vars.remove(var);
+}
+
+// Kreira privremenu registarsku promenljivu za jedno korišćenje ili definiciju prosute promenljive
+Variable* LivenessAnalysis::createSpillTemp(Variable* var)
+{
+	Variable* temp = syntax.getContext().newVariable(Variable::REG_VAR, var->getName() + "_s" + std::to_string(spillTemps.size()));
+	reg_vars.push_back(temp);
+	spillTemps.insert(temp);
+	return temp;
+}
+
+// Prenumeriše registarske promenljive i instrukcije nakon umetanja koda za prosipanje
+void LivenessAnalysis::renumber()
+{
+	int pos = 0;
+	for (Variable* v : reg_vars)
+		v->setPos(pos++);
+	pos = 0;
+	for (Instruction* i : instrs)
+		i->setPos(pos++);
 }
 
 // Postavlja upotrebu (use) i definiciju (def) varijabli u instrukcijama.
@@ -267,58 +619,32 @@ void LivenessAnalysis::setUseAndDef()
 }
 
 // Ispisuje informacije o registrima.
-void LivenessAnalysis::printRegisters()
+void LivenessAnalysis::printRegisters(std::ostream& out)
 {
-	std::cout << ">>>>>=====-----\n"
+	out << ">>>>>=====-----\n"
 		<< "|  Registers : \n"
 		<< ">>>>>=====-----\n";
-	print(reg_vars);
+	print(reg_vars, out);
 }
 
 // Ispisuje graf interferencije.
-void LivenessAnalysis::printGraph()
+void LivenessAnalysis::printGraph(std::ostream& out)
 {
-	std::cout << "=---===============---=\n"
+	out << "=---===============---=\n"
 		<< "| Interference Matrix |\n"
 		<< "=---===============---=\n";
-	for (int j = 0; j < (int)interferenceGraph.size(); ++j)
-	{
-		std::cout << "[";
-		for (std::vector<int>::iterator it = interferenceGraph[j].begin();
-		it != interferenceGraph[j].end();
-			++it)
-		{
-			std::cout << ' ' << *it;
-		}
-		std::cout << " ]\n";
-	}
+	interferenceGraph.print(out);
 }
 
 // Postavlja interferenciju između dve varijable u grafu interferencije.
 void LivenessAnalysis::setInterference(int x, int y)
 {
-	interferenceGraph[y][x] = 1;
-	interferenceGraph[x][y] = 1;
+	interferenceGraph.addEdge(x, y);
 }
 
 // Upisuje generisanu asemblersku datoteku.
-void LivenessAnalysis::writeToFile(std::string& nameOfOutputFile)
+void LivenessAnalysis::writeToFile(std::string& nameOfOutputFile, bool noReorder)
 {
-	std::ofstream file(nameOfOutputFile);
-	if (!file.is_open())
-		throw std::runtime_error("\nException! Wasn\'t able to create the output file!");
-
-	file << ".globl " << instrs.front()->getLabel()->get() << "\n\n";
-
-	file << ".data" << std::endl;
-	for (Variable* v : mem_vars)
-		file << v->get() << ":\t.word " << v->getValue() << std::endl;
-	file << "\n";
-
-	file << ".text" << std::endl;
-	for (Instruction* i : instrs)
-		file << *i << std::endl;
-
-	file << "\tjr $ra";
-	file.close();
+	Emitter emitter(nameOfOutputFile);
+	emitter.emit(instrs, mem_vars, noReorder);
 }
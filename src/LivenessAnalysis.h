@@ -4,6 +4,15 @@
 #define LIVNESS_ANALYSIS_H
 
 #include "SyntaxAnalysis.h"
+#include "ControlFlowGraph.h"
+#include "ConstantPropagation.h"
+#include "LoopInvariantMotion.h"
+#include "InterferenceGraph.h"
+#include "GraphColoring.h"
+#include "LinearScan.h"
+#include "Target.h"
+
+#include <unordered_set>
 
 /**
 * Class that does liveness analysis of register variables and assigns them processor registers
@@ -14,28 +23,32 @@ public:
 	/**
 	* Constructior with paramaters
 	* [in] syntax - SyntaxAnalysis object from which LivenessAnalysis takes instructions and variables
+	* [in] target - description of the registers which can be allocated
+	* [in] allocator - register allocation algorithm
 	*/
-	LivenessAnalysis(SyntaxAnalysis& syntax);
+	LivenessAnalysis(SyntaxAnalysis& syntax, const Target& target, RegAllocType allocator = RA_GRAPH_COLORING);
 
 	/**
-	* Method which runs all the liveness analysis and resource allocation methods
+	* Method which runs all the liveness analysis and resource allocation methods. Variables that
+	* can't be colored are spilled to memory and the analysis is repeated on the rewritten code
 	* [out] return - boolean value if everything was done correctly
 	*/
 	bool Do();
 	/**
 	* Creates a file with the given path and writes the analysed code into it if everything was done correctly
 	* [in] nameOfOutputFile - string of the path where the output file is
+	* [in] noReorder - branch delay slots are filled, the assembler must not reorder the code
 	*/
-	void writeToFile(std::string& nameOfOutputFile);
+	void writeToFile(std::string& nameOfOutputFile, bool noReorder = false);
 	/**
-	* Method for printing to the terminal all the register variables after they got
+	* Method for printing all the register variables after they got
 	* assigned an actual processor register
 	*/
-	void printRegisters();
+	void printRegisters(std::ostream& out = std::cout);
 	/**
-	* Method which prints the interference matrix/graph to the terminal
+	* Method which prints the interference matrix/graph
 	*/
-	void printGraph();
+	void printGraph(std::ostream& out = std::cout);
 
 private:
 	/**
@@ -43,50 +56,104 @@ private:
 	*/
 	void liveness();
 	/**
-	* Method which prepares the interference matrix/graph
+	* Removes instructions of blocks unreachable from the entry and instructions whose
+	* defined registers are all dead after them (stores and branches are always kept). A dead
+	* instruction whose label can't move to the next instruction is replaced by a labelled nop
+	* [out] return - true if the code was changed and liveness has to be recomputed
+	*/
+	bool removeDeadCode();
+	/**
+	* Method which prepares the interference matrix/graph. The destination of a copy doesn't
+	* interfere with its source at the copy, so copy related variables can be coalesced
 	*/
 	void setGraph();
+
+	/**
+	* Conservative (Briggs/George) coalescing: merges non interfering copy related variables
+	* and deletes the copies. A merge is done only if it can't make the graph uncolorable
+	* [out] return - true if the code was changed and liveness has to be recomputed
+	*/
+	bool coalesce();
+	/**
+	* Briggs test: the merged node has fewer than K neighbours of significant degree
+	*/
+	bool briggsTest(int x, int y, int k);
+	/**
+	* George test: every neighbour of y already interferes with x or has insignificant degree
+	*/
+	bool georgeTest(int x, int y, int k);
+	/**
+	* Returns the source if the instruction copies one register variable into another
+	* (addi x, y, 0 or add/or/sub with a register that always holds zero), otherwise nullptr
+	*/
+	Variable* copySource(Instruction* in);
+	/**
+	* Finds register variables whose only definition is li r, 0
+	*/
+	void findZeroRegisters();
 	/**
 	* Method which allocates processor registers to register variables
+	* [out] return - positions of the variables which have to be spilled (empty on success)
+	*/
+	std::vector<int> resourceAllocation();
+	/**
+	* Method which allocates processor registers with a linear scan over live intervals
+	* (no interference graph and no coalescing, for very large inputs)
+	* [out] return - positions of the variables which have to be spilled (empty on success)
 	*/
-	void resourceAllocation();
+	std::vector<int> linearScan();
 
 	/**
-	* Method that sets all predecessors and successor of all instructions
+	* Rewrites the code so that the variable lives in a new memory slot: every use is preceded by
+	* a load into a fresh temporary and every definition is followed by a store. The variable is
+	* removed from the register variables and deleted
+	* [in] var - register variable to spill
+	*/
+	void spill(Variable* var);
+	/**
+	* Creates a new register variable used only around one spilled use or definition
+	* [in] var - spilled variable the temporary stands for
+	* [out] return - pointer to the created variable
 	*/
-	void setPredAndSucc();
+	Variable* createSpillTemp(Variable* var);
+	/**
+	* Renumbers register variables and instructions after spill code was inserted
+	*/
+	void renumber();
+
 	/**
 	* Method that sets all used and defined variables of all instructions
 	*/
 	void setUseAndDef();
 
 	/**
-	* Method that ensures that the interference matrix is symmetrical over the main diagonal
+	* Method that adds an interference edge between two variables
 	* [in] x - position of one variable
 	* [in] y - position of the other variable which interferes with the first one
 	*/
 	void setInterference(int x, int y);
 
 	/**
-	* Method which creates the simplification stack used for resource allocation
-	* [out] return - stack of variables in order of their rang in the graph
-	*/
-	std::stack<Variable*> createSimplificationStack();
-	/**
-	* Method that determines what register should a given variable get compared to the interference
-	* matrix/graph and other variables that got their register assigned
-	* [in]  var    - pointer to the variable for which the color (register) is being chosen for
-	* [out] return - next free color (register)
+	* Method which computes the spill cost of every register variable as the number of its uses and
+	* definitions, each weighted by 10^(loop depth). Spill temporaries can't be spilled again
+	* [out] return - costs indexed by variable position
 	*/
-	int getColor(Variable* var);
+	std::vector<double> spillCosts();
 
+	SyntaxAnalysis& syntax;                         // Owner of the variables and instructions
+	const Target& target;                           // Allocatable registers
+	RegAllocType allocator;                         // Register allocation algorithm
+	Dump& dump;                                     // Dump settings of the compilation
+	TimeReport& report;                             // Phase timing of the compilation
 	bool err;                                       // Boolean value that represents if there has been an error during livness analysis
 	Variables& reg_vars;                            // List of register variables
 	Variables& mem_vars;                            // List of memory variables
-	Variables vars;                                 // List of variables that gets filled when a variable gets assigned a register
 	Instructions& instrs;                           // List of instructions
-	typedef std::vector<std::vector<int>> Matrix;   // Matrix type defined  to represent the interference graph
-	Matrix interferenceGraph;                       // Interference graph
+	ControlFlowGraph cfg;                           // Basic blocks of the instructions
+	InterferenceGraph interferenceGraph;            // Interference graph
+	std::vector<Variable*> regsByPos;               // Register variables indexed by their position (graph node)
+	std::unordered_set<Variable*> spillTemps;       // Temporaries created by spill code
+	std::unordered_set<Variable*> zeroRegs;         // Register variables which always hold zero
 };
 
 #endif#pragma once
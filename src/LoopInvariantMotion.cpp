@@ -0,0 +1,187 @@
+#include "LoopInvariantMotion.h"
+#include "Dump.h"
+
+#include <unordered_map>
+#include <unordered_set>
+
+LoopInvariantMotion::LoopInvariantMotion(SyntaxAnalysis& syntax, ControlFlowGraph& cfg) :
+	syntax(syntax), instrs(syntax.getInstructions()), cfg(cfg)
+{
+}
+
+// Izvlači invarijantne instrukcije iz najdublje petlje koja ih ima
+bool LoopInvariantMotion::Do()
+{
+	std::vector<Loop>& loops = cfg.getLoops();
+	for (std::vector<Loop>::reverse_iterator it = loops.rbegin(); it != loops.rend(); ++it)
+	{
+		Loop& loop = *it;
+		if (loop.header == cfg.getEntry())
+			continue;
+
+		inLoop.assign(cfg.getBlocks().size(), false);
+		for (BasicBlock* b : loop.blocks)
+			inLoop[b->getId()] = true;
+
+		std::vector<Instruction*> invariants = findInvariants(loop);
+		if (!invariants.empty() && hoist(loop, invariants))
+			return true;
+	}
+	return false;
+}
+
+// Pronalazi invarijantne instrukcije petlje redom kojim mogu da se izvuku
+std::vector<Instruction*> LoopInvariantMotion::findInvariants(Loop& loop)
+{
+	// broj definicija svake promenljive u petlji
+	std::unordered_map<Variable*, int> defs;
+	for (BasicBlock* b : loop.blocks)
+		for (Instruction* in : b->getInstructions())
+			for (Variable* v : in->getDef())
+				++defs[v];
+
+	// izlazni blokovi i blokovi van petlje u koje se iz njih prelazi
+	std::vector<BasicBlock*> exiting;
+	std::vector<BasicBlock*> exits;
+	for (BasicBlock* b : loop.blocks)
+	{
+		bool isExiting = false;
+		for (BasicBlock* s : b->getSucc())
+			if (!inLoop[s->getId()])
+			{
+				exits.push_back(s);
+				isExiting = true;
+			}
+		if (isExiting)
+			exiting.push_back(b);
+	}
+
+	std::vector<Instruction*> invariants;
+	std::unordered_set<Instruction*> hoisted;
+	std::unordered_set<Variable*> hoistedDefs;
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (BasicBlock* b : loop.blocks)
+		{
+			bool dominatesExits = true;
+			for (BasicBlock* e : exiting)
+				dominatesExits = dominatesExits && cfg.dominates(b, e);
+
+			for (Instruction* in : b->getInstructions())
+			{
+				InstructionType type = in->getType();
+				bool canTrap = type == I_ADD || type == I_ADDI || type == I_SUB;
+				bool pure = type == I_LA || type == I_LI || canTrap ||
+					type == I_AND || type == I_OR || type == I_NOT;
+				// labela se može premestiti samo sa početka zaglavlja (na sledeću instrukciju zaglavlja)
+				bool movableLabel = in->getLabel() == nullptr || in == loop.header->getInstructions().front();
+				if (!pure || !movableLabel || hoisted.count(in) != 0 || in->getDef().size() != 1)
+					continue;
+
+				Variable* d = in->getDef().front();
+				if (defs[d] != 1 || loop.header->getIn().test(d->getPos()))
+					continue;
+
+				bool invariant = true;
+				for (Variable* s : in->getUse())
+					if (defs.count(s) != 0 && defs[s] != 0 && hoistedDefs.count(s) == 0)
+						invariant = false;
+				if (!invariant)
+					continue;
+
+				// izvršava se u svakom prolazu kroz petlju ili je rezultat mrtav nakon nje
+				if (!dominatesExits)
+				{
+					if (canTrap)
+						continue;
+					for (BasicBlock* e : exits)
+						if (e->getIn().test(d->getPos()))
+							invariant = false;
+					if (!invariant)
+						continue;
+				}
+
+				invariants.push_back(in);
+				hoisted.insert(in);
+				hoistedDefs.insert(d);
+				changed = true;
+			}
+		}
+	}
+	return invariants;
+}
+
+// Premešta instrukcije ispred zaglavlja petlje
+bool LoopInvariantMotion::hoist(Loop& loop, std::vector<Instruction*>& invariants)
+{
+	std::vector<BasicBlock*>& blocks = cfg.getBlocks();
+	Instruction* first = loop.header->getInstructions().front();
+	Variable* headerLabel = first->getLabel();
+
+	// blok ispred zaglavlja koji u njega propada mora biti van petlje, jer se u njega upisuje preheader
+	int previous = loop.header->getId() - 1;
+	if (previous >= 0 && inLoop[previous])
+		for (BasicBlock* s : blocks[previous]->getSucc())
+			if (s == loop.header && blocks[previous]->getInstructions().back()->getType() != I_B)
+				return false;
+
+	// labela zaglavlja prelazi na prvu instrukciju zaglavlja koja ostaje u petlji
+	std::unordered_set<Instruction*> moving(invariants.begin(), invariants.end());
+	Instruction* newFirst = nullptr;
+	for (Instruction* in : loop.header->getInstructions())
+		if (moving.count(in) == 0)
+		{
+			newFirst = in;
+			break;
+		}
+	if (newFirst == nullptr)
+		return false;
+	if (newFirst != first)
+	{
+		first->removeLabel();
+		if (headerLabel != nullptr)
+			newFirst->addLabel(headerLabel);
+		first = newFirst;
+	}
+
+	// skokovi spolja na zaglavlje prelaze na labelu preheadera
+	std::vector<Instruction*> entries;
+	for (BasicBlock* p : loop.header->getPred())
+	{
+		Instruction* last = p->getInstructions().back();
+		if (!inLoop[p->getId()] && isBranch(last->getType()) && last->getSrc().back() == headerLabel)
+			entries.push_back(last);
+	}
+
+	Instructions::iterator position = instrs.end();
+	for (Instructions::iterator it = instrs.begin(); it != instrs.end();)
+	{
+		if (moving.count(*it) != 0)
+			it = instrs.erase(it);
+		else
+		{
+			if (*it == first)
+				position = it;
+			++it;
+		}
+	}
+
+	for (Instruction* in : invariants)
+		instrs.insert(position, in);
+
+	if (!entries.empty())
+	{
+		Variable* label = syntax.newLabel("_pre_" + headerLabel->getName());
+		invariants.front()->addLabel(label);
+		for (Instruction* branch : entries)
+			branch->replaceVariable(headerLabel, label);
+	}
+
+	Dump& dump = syntax.getContext().getDump();
+	if (dump.enabled(DUMP_PASSES))
+		dump.stream() << "Hoisted " << invariants.size() << " instructions out of the loop at "
+			<< (headerLabel != nullptr ? headerLabel->getName() : "block " + std::to_string(loop.header->getId())) << std::endl;
+	return true;
+}
@@ -0,0 +1,54 @@
+#ifndef __LOOP_INVARIANT_MOTION__
+#define __LOOP_INVARIANT_MOTION__
+
+#include "SyntaxAnalysis.h"
+#include "ControlFlowGraph.h"
+
+
+/**
+ * Loop invariant code motion over the natural loops of the control flow graph
+ * (ControlFlowGraph::computeLoops) using block liveness (LivenessAnalysis::liveness).
+ *
+ * An instruction d = op(s...) is moved to the loop preheader when:
+ *  - it is la, li or arithmetic and the only definition of d in the loop (the only label it
+ *    may have is the header label, which then moves to the next instruction of the header),
+ *  - every register operand is defined outside the loop or by an already hoisted instruction,
+ *  - d is not live at the loop header (no use in the loop sees another value of d),
+ *  - its block dominates every loop exit, or, for la/li which can't trap, d is dead at every exit.
+ * The preheader is the code placed just before the header in the instruction list. Branches
+ * from outside the loop which target the header are redirected to a new label of the preheader.
+ */
+class LoopInvariantMotion
+{
+public:
+	/**
+	 * [in] syntax - owner of the instructions and labels
+	 * [in] cfg    - basic blocks with computed loops and live sets
+	 */
+	LoopInvariantMotion(SyntaxAnalysis& syntax, ControlFlowGraph& cfg);
+
+	/**
+	 * Hoists the invariant instructions of the innermost loop which has any
+	 * [out] return - true if the code was changed (cfg and liveness have to be recomputed)
+	 */
+	bool Do();
+
+private:
+	/**
+	 * Finds the invariant instructions of the loop in the order in which they can be hoisted
+	 */
+	std::vector<Instruction*> findInvariants(Loop& loop);
+
+	/**
+	 * Moves the instructions in front of the loop header
+	 * [out] return - false if the loop has no place for a preheader
+	 */
+	bool hoist(Loop& loop, std::vector<Instruction*>& invariants);
+
+	SyntaxAnalysis& syntax;
+	Instructions& instrs;
+	ControlFlowGraph& cfg;
+	std::vector<bool> inLoop;       // Blocks of the loop being processed
+};
+
+#endif
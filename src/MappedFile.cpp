@@ -0,0 +1,143 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+
+MappedFile::MappedFile() : m_data(NULL), m_size(0), m_fileHandle(NULL), m_mappingHandle(NULL)
+{
+}
+
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+
+#ifdef _WIN32
+
+bool MappedFile::open(const string& fileName)
+{
+	close();
+
+	HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(file, &length) || length.QuadPart <= 0 || length.HighPart != 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping == NULL)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == NULL)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_data = (const char*)view;
+	m_size = (unsigned int)length.QuadPart;
+	m_fileHandle = file;
+	m_mappingHandle = mapping;
+	return true;
+}
+
+
+void MappedFile::close()
+{
+	if (m_data != NULL)
+		UnmapViewOfFile(m_data);
+	if (m_mappingHandle != NULL)
+		CloseHandle((HANDLE)m_mappingHandle);
+	if (m_fileHandle != NULL)
+		CloseHandle((HANDLE)m_fileHandle);
+
+	m_data = NULL;
+	m_size = 0;
+	m_fileHandle = NULL;
+	m_mappingHandle = NULL;
+}
+
+#else
+
+bool MappedFile::open(const string& fileName)
+{
+	close();
+
+	int fd = ::open(fileName.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	// dužina programa se čuva u 32 bita, kao i na Windows-u se veći fajl odbija
+	struct stat info;
+	if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0 ||
+		(unsigned long long)info.st_size > 0xFFFFFFFFull)
+	{
+		::close(fd);
+		return false;
+	}
+
+	void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	// the mapping keeps its own reference to the file
+	::close(fd);
+	if (view == MAP_FAILED)
+		return false;
+
+	madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+
+	m_data = (const char*)view;
+	m_size = (unsigned int)info.st_size;
+	return true;
+}
+
+
+void MappedFile::close()
+{
+	if (m_data != NULL)
+		munmap((void*)m_data, m_size);
+
+	m_data = NULL;
+	m_size = 0;
+}
+
+#endif
+
+
+bool MappedFile::isOpen() const
+{
+	return m_data != NULL;
+}
+
+
+const char* MappedFile::data() const
+{
+	return m_data;
+}
+
+
+unsigned int MappedFile::size() const
+{
+	return m_size;
+}
@@ -0,0 +1,69 @@
+#ifndef __MAPPED_FILE__
+#define __MAPPED_FILE__
+
+#include <string>
+
+
+/**
+ * Read-only memory mapping of a whole file
+ */
+class MappedFile
+{
+public:
+	MappedFile();
+
+	/**
+	 * Unmaps the file if it is still mapped
+	 */
+	~MappedFile();
+
+	/**
+	 * Maps the file with the given name read-only into memory
+	 * [in] fileName - path of the file to map
+	 * [out] return - false if the file could not be opened or mapped (e.g. it is empty or
+	 *	its size doesn't fit into 32 bits)
+	 */
+	bool open(const std::string& fileName);
+
+	/**
+	 * Unmaps the file, all pointers into the mapping become invalid
+	 */
+	void close();
+
+	/**
+	 * Returns true if a file is currently mapped
+	 */
+	bool isOpen() const;
+
+	/**
+	 * Returns the first character of the mapped file
+	 */
+	const char* data() const;
+
+	/**
+	 * Returns the number of mapped characters
+	 */
+	unsigned int size() const;
+
+private:
+	MappedFile(const MappedFile&);
+	MappedFile& operator=(const MappedFile&);
+
+	/**
+	 * Start of the mapping
+	 */
+	const char* m_data;
+
+	/**
+	 * Length of the mapping in bytes
+	 */
+	unsigned int m_size;
+
+	/**
+	 * Platform handles of the opened file and of the mapping (only used on Windows)
+	 */
+	void* m_fileHandle;
+	void* m_mappingHandle;
+};
+
+#endif
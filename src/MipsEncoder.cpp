@@ -0,0 +1,211 @@
+#include "MipsEncoder.h"
+
+#include "ControlFlowGraph.h"
+#include "Target.h"
+
+#include <stdexcept>
+
+namespace
+{
+	const unsigned int OP_REGIMM = 0x01;
+	const unsigned int OP_BEQ = 0x04;
+	const unsigned int OP_BNE = 0x05;
+	const unsigned int OP_ADDI = 0x08;
+	const unsigned int OP_ADDIU = 0x09;
+	const unsigned int OP_ORI = 0x0d;
+	const unsigned int OP_LUI = 0x0f;
+	const unsigned int OP_LW = 0x23;
+	const unsigned int OP_SW = 0x2b;
+
+	const unsigned int FUNCT_JR = 0x08;
+	const unsigned int FUNCT_ADD = 0x20;
+	const unsigned int FUNCT_SUB = 0x22;
+	const unsigned int FUNCT_AND = 0x24;
+	const unsigned int FUNCT_OR = 0x25;
+	const unsigned int FUNCT_NOR = 0x27;
+
+	const unsigned int REG_RA = 31;
+	const unsigned int NOP = 0;
+}
+
+MipsEncoder::MipsEncoder(bool noReorder) : noReorder(noReorder)
+{
+}
+
+// Vraća broj reči u koje se instrukcija kodira
+int MipsEncoder::size(Instruction* in) const
+{
+	switch (in->getType())
+	{
+	case I_NO_TYPE:
+		return 0;
+	case I_LA:
+		return 2;
+	case I_LI:
+	{
+		int value = in->getSrc().front()->getValue();
+		return value >= -32768 && value <= 65535 ? 1 : 2;
+	}
+	default:
+		return isBranch(in->getType()) && !noReorder ? 2 : 1;
+	}
+}
+
+// Vraća broj registra dodeljenog promenljivoj
+unsigned int MipsEncoder::reg(Variable* var) const
+{
+	int number = Target::getRegisterNumber(var->getRegisterName());
+	if (number < 0)
+		throw std::runtime_error("\nException! Register " + var->getRegisterName() + " of " + var->getName() + " can't be encoded!\n");
+	return (unsigned int)number;
+}
+
+// Vraća pomeraj skoka u rečima od delay slota do labele
+unsigned int MipsEncoder::branchOffset(unsigned int address, Variable* label) const
+{
+	int offset = ((int)labels.at(label) - (int)(address + 4)) / 4;
+	if (offset < -32768 || offset > 32767)
+		throw std::runtime_error("\nException! Branch to " + label->getName() + " is out of range!\n");
+	return (unsigned int)offset & 0xffff;
+}
+
+// Vraća 16-bitnu neposrednu vrednost
+unsigned int MipsEncoder::immediate(int value)
+{
+	if (value < -32768 || value > 32767)
+		throw std::runtime_error("\nException! Constant " + std::to_string(value) + " doesn't fit in 16 bits!\n");
+	return (unsigned int)value & 0xffff;
+}
+
+unsigned int MipsEncoder::typeR(unsigned int rs, unsigned int rt, unsigned int rd, unsigned int funct)
+{
+	return (rs << 21) | (rt << 16) | (rd << 11) | funct;
+}
+
+unsigned int MipsEncoder::typeI(unsigned int op, unsigned int rs, unsigned int rt, unsigned int imm)
+{
+	return (op << 26) | (rs << 21) | (rt << 16) | (imm & 0xffff);
+}
+
+// Kodira funkciju i memorijske promenljive
+ObjectCode MipsEncoder::encode(Instructions& instrs, Variables& memVars)
+{
+	ObjectCode code;
+	code.noReorder = noReorder;
+	labels.clear();
+
+	std::unordered_map<Variable*, unsigned int> dataOffsets;
+	for (Variable* v : memVars)
+	{
+		dataOffsets[v] = 4 * (unsigned int)code.data.size();
+		ObjectCode::Symbol symbol = { v->getName(), 4 * (unsigned int)code.data.size(), 4, true, false, false };
+		code.symbols.push_back(symbol);
+		code.data.push_back((unsigned int)v->getValue());
+	}
+
+	// prvi prolaz: adrese instrukcija i labela
+	unsigned int address = 0;
+	for (Instruction* in : instrs)
+	{
+		if (in->getLabel() != nullptr)
+		{
+			labels[in->getLabel()] = address;
+			ObjectCode::Symbol symbol = { in->getLabel()->getName(), address, 0, false, in->isFunc(), in->isFunc() };
+			code.symbols.push_back(symbol);
+		}
+		address += 4 * size(in);
+	}
+	unsigned int textSize = address + 8;
+	for (ObjectCode::Symbol& symbol : code.symbols)
+		if (symbol.function)
+			symbol.size = textSize - symbol.value;
+
+	// drugi prolaz: kodiranje
+	code.text.reserve(textSize / 4);
+	for (Instruction* in : instrs)
+	{
+		unsigned int pc = 4 * (unsigned int)code.text.size();
+		Operands& dst = in->getDst();
+		Operands& src = in->getSrc();
+		Operands::iterator s = src.begin();
+		Variable* s1 = src.empty() ? nullptr : *s++;
+		Variable* s2 = s == src.end() ? nullptr : *s++;
+		Variable* s3 = s == src.end() ? nullptr : *s;
+		Variable* d = dst.empty() ? nullptr : dst.front();
+
+		switch (in->getType())
+		{
+		case I_NO_TYPE:
+			break;
+		case I_ADD:
+			code.text.push_back(typeR(reg(s1), reg(s2), reg(d), FUNCT_ADD));
+			break;
+		case I_SUB:
+			code.text.push_back(typeR(reg(s1), reg(s2), reg(d), FUNCT_SUB));
+			break;
+		case I_AND:
+			code.text.push_back(typeR(reg(s1), reg(s2), reg(d), FUNCT_AND));
+			break;
+		case I_OR:
+			code.text.push_back(typeR(reg(s1), reg(s2), reg(d), FUNCT_OR));
+			break;
+		case I_NOT:
+			code.text.push_back(typeR(reg(s1), 0, reg(d), FUNCT_NOR));
+			break;
+		case I_ADDI:
+			code.text.push_back(typeI(OP_ADDI, reg(s1), reg(d), immediate(s2->getValue())));
+			break;
+		case I_LA:
+		{
+			// donja polovina se proširuje znakom, pa se gornja zaokružuje
+			unsigned int offset = dataOffsets.at(s1);
+			ObjectCode::Relocation hi = { pc, ObjectCode::DATA_SECTION, R_MIPS_HI16 };
+			ObjectCode::Relocation lo = { pc + 4, ObjectCode::DATA_SECTION, R_MIPS_LO16 };
+			code.relocations.push_back(hi);
+			code.relocations.push_back(lo);
+			code.text.push_back(typeI(OP_LUI, 0, reg(d), (offset + 0x8000) >> 16));
+			code.text.push_back(typeI(OP_ADDIU, reg(d), reg(d), offset));
+			break;
+		}
+		case I_LI:
+		{
+			int value = s1->getValue();
+			if (value >= -32768 && value <= 32767)
+				code.text.push_back(typeI(OP_ADDIU, 0, reg(d), (unsigned int)value));
+			else if (value >= 0 && value <= 65535)
+				code.text.push_back(typeI(OP_ORI, 0, reg(d), (unsigned int)value));
+			else
+			{
+				code.text.push_back(typeI(OP_LUI, 0, reg(d), (unsigned int)value >> 16));
+				code.text.push_back(typeI(OP_ORI, reg(d), reg(d), (unsigned int)value));
+			}
+			break;
+		}
+		case I_LW:
+			code.text.push_back(typeI(OP_LW, reg(s2), reg(d), immediate(s1->getValue())));
+			break;
+		case I_SW:
+			code.text.push_back(typeI(OP_SW, reg(s3), reg(s1), immediate(s2->getValue())));
+			break;
+		case I_B:
+			code.text.push_back(typeI(OP_BEQ, 0, 0, branchOffset(pc, s1)));
+			break;
+		case I_BLTZ:
+			code.text.push_back(typeI(OP_REGIMM, reg(s1), 0, branchOffset(pc, s2)));
+			break;
+		case I_BNE:
+			code.text.push_back(typeI(OP_BNE, reg(s1), reg(s2), branchOffset(pc, s3)));
+			break;
+		case I_NOP:
+			code.text.push_back(NOP);
+			break;
+		}
+
+		if (isBranch(in->getType()) && !noReorder)
+			code.text.push_back(NOP);
+	}
+
+	code.text.push_back(typeR(REG_RA, 0, 0, FUNCT_JR));
+	code.text.push_back(NOP);
+	return code;
+}
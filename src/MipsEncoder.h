@@ -0,0 +1,107 @@
+#ifndef __MIPS_ENCODER__
+#define __MIPS_ENCODER__
+
+#include "IR.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * Machine code of one function with everything the object file writer needs
+ */
+struct ObjectCode
+{
+	/**
+	 * Symbol defined in .text (labels, the function) or .data (memory variables)
+	 */
+	struct Symbol
+	{
+		std::string name;
+		unsigned int value;         // Offset in its section
+		unsigned int size;
+		bool data;                  // Defined in .data, otherwise in .text
+		bool global;
+		bool function;
+	};
+
+	/**
+	 * Relocation of a .text word (the addend is in the instruction)
+	 */
+	struct Relocation
+	{
+		unsigned int offset;        // Offset of the word in .text
+		int symbol;                 // Index in symbols, DATA_SECTION for the .data section symbol
+		int type;                   // R_MIPS_HI16 or R_MIPS_LO16
+	};
+
+	static const int DATA_SECTION = -1;
+
+	std::vector<unsigned int> text;
+	std::vector<unsigned int> data;
+	std::vector<Symbol> symbols;
+	std::vector<Relocation> relocations;
+	bool noReorder;
+};
+
+const int R_MIPS_HI16 = 5;
+const int R_MIPS_LO16 = 6;
+
+
+/**
+ * Encodes the allocated instructions into MIPS32 words.
+ *
+ * The same code the assembler would produce from the emitted .s file:
+ *	la  r, m      -> lui r, %hi(m); addiu r, r, %lo(m)  (HI16/LO16 relocations against .data,
+ *	                 the offset of m is the addend, as the assembler does for local symbols)
+ *	li  r, c      -> addiu r, $zero, c / ori r, $zero, c / lui r, hi(c); ori r, r, lo(c)
+ *	not d, s      -> nor d, s, $zero
+ *	b   l         -> beq $zero, $zero, l
+ * Without noreorder every branch gets a nop in its delay slot, like the assembler adds.
+ * The function ends with jr $ra and a nop. Layout is done in two passes: the first one gives
+ * every instruction and label its address, the second one encodes with resolved branch offsets.
+ */
+class MipsEncoder
+{
+public:
+	/**
+	 * [in] noReorder - branch delay slots are already filled in the instruction list
+	 */
+	MipsEncoder(bool noReorder);
+
+	/**
+	 * Encodes the function and its memory variables
+	 * throws runtime_error for a register without a hardware number or a branch out of range
+	 */
+	ObjectCode encode(Instructions& instrs, Variables& memVars);
+
+private:
+	/**
+	 * Returns the number of words the instruction is encoded in
+	 */
+	int size(Instruction* in) const;
+
+	/**
+	 * Returns the hardware number of the register assigned to the variable
+	 */
+	unsigned int reg(Variable* var) const;
+
+	/**
+	 * Returns the 16 bit word offset from the delay slot of the branch at address to the label
+	 */
+	unsigned int branchOffset(unsigned int address, Variable* label) const;
+
+	/**
+	 * Returns the signed 16 bit immediate, throws runtime_error if the value doesn't fit
+	 */
+	static unsigned int immediate(int value);
+
+	static unsigned int typeR(unsigned int rs, unsigned int rt, unsigned int rd, unsigned int funct);
+	static unsigned int typeI(unsigned int op, unsigned int rs, unsigned int rt, unsigned int imm);
+
+	bool noReorder;
+	std::unordered_map<Variable*, unsigned int> labels;     // Address of the instruction with the label
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "NameTable.h"
+
+#include <cstring>
+
+using namespace std;
+
+
+/**
+ * Initial number of slots, must be a power of two
+ */
+static const unsigned int INITIAL_SLOTS = 64;
+
+
+NameTable::NameTable() : m_slots(INITIAL_SLOTS, -1)
+{
+}
+
+
+unsigned int NameTable::hash(const Lexeme& name)
+{
+	unsigned int h = 2166136261u;
+	for (int i = 0; i < name.length(); i++)
+	{
+		h ^= (unsigned char)name[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+
+unsigned int NameTable::findSlot(const Lexeme& name, unsigned int h) const
+{
+	unsigned int mask = (unsigned int)m_slots.size() - 1;
+	unsigned int slot = h & mask;
+	while (true)
+	{
+		int id = m_slots[slot];
+		if (id == -1)
+			return slot;
+
+		const Lexeme& other = m_names[id];
+		if (m_hashes[id] == h && other.length() == name.length() &&
+			memcmp(other.data(), name.data(), name.length()) == 0)
+			return slot;
+
+		slot = (slot + 1) & mask;
+	}
+}
+
+
+int NameTable::intern(const Lexeme& name)
+{
+	unsigned int h = hash(name);
+	unsigned int slot = findSlot(name, h);
+	if (m_slots[slot] != -1)
+		return m_slots[slot];
+
+	int id = (int)m_names.size();
+	m_names.push_back(name);
+	m_hashes.push_back(h);
+	m_slots[slot] = id;
+
+	// keep the load factor under one half
+	if (m_names.size() * 2 > m_slots.size())
+		grow();
+
+	return id;
+}
+
+
+int NameTable::find(const Lexeme& name) const
+{
+	return m_slots[findSlot(name, hash(name))];
+}
+
+
+const Lexeme& NameTable::getName(int id) const
+{
+	return m_names[id];
+}
+
+
+int NameTable::size() const
+{
+	return (int)m_names.size();
+}
+
+
+void NameTable::clear()
+{
+	m_slots.assign(INITIAL_SLOTS, -1);
+	m_names.clear();
+	m_hashes.clear();
+}
+
+
+void NameTable::grow()
+{
+	m_slots.assign(m_slots.size() * 2, -1);
+	unsigned int mask = (unsigned int)m_slots.size() - 1;
+	for (int id = 0; id < (int)m_names.size(); id++)
+	{
+		unsigned int slot = m_hashes[id] & mask;
+		while (m_slots[slot] != -1)
+			slot = (slot + 1) & mask;
+		m_slots[slot] = id;
+	}
+}
@@ -0,0 +1,77 @@
+#ifndef __NAME_TABLE__
+#define __NAME_TABLE__
+
+#include <vector>
+
+#include "Token.h"
+
+
+/**
+ * Interns identifier names read from the program text.
+ * Every distinct name gets a small dense id (0, 1, 2, ...), so later phases can compare and
+ * index names by number instead of by string. Names are stored as views into the program text,
+ * so the table must not outlive the text it was filled from.
+ */
+class NameTable
+{
+public:
+	NameTable();
+
+	/**
+	 * Returns the id of the given name, assigning a new one if the name was not seen before
+	 */
+	int intern(const Lexeme& name);
+
+	/**
+	 * Returns the id of the given name or -1 if the name was never interned
+	 */
+	int find(const Lexeme& name) const;
+
+	/**
+	 * Returns the name with the given id
+	 */
+	const Lexeme& getName(int id) const;
+
+	/**
+	 * Returns the number of interned names
+	 */
+	int size() const;
+
+	/**
+	 * Removes all names
+	 */
+	void clear();
+
+private:
+	/**
+	 * FNV-1a hash of the name characters
+	 */
+	static unsigned int hash(const Lexeme& name);
+
+	/**
+	 * Returns the slot holding the given name or the empty slot where it should be inserted
+	 */
+	unsigned int findSlot(const Lexeme& name, unsigned int h) const;
+
+	/**
+	 * Doubles the number of slots and reinserts all ids
+	 */
+	void grow();
+
+	/**
+	 * Open addressing table with linear probing, holds name ids (-1 is an empty slot)
+	 */
+	std::vector<int> m_slots;
+
+	/**
+	 * Interned names indexed by id
+	 */
+	std::vector<Lexeme> m_names;
+
+	/**
+	 * Hashes of the interned names indexed by id, so growing does not rehash the characters
+	 */
+	std::vector<unsigned int> m_hashes;
+};
+
+#endif
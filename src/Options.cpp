@@ -0,0 +1,155 @@
+#include "Options.h"
+#include "Dump.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+
+using namespace std;
+
+
+CompilerOptions::CompilerOptions() :
+	inputFile(".\\..\\examples\\simple.mavn"),
+	outputFile(".\\..\\examples\\out.s"),
+	streamTokens(false),
+	allocator(RA_GRAPH_COLORING),
+	schedule(SCHED_NONE),
+	simulate(false),
+	simulateSteps(100000000),
+	timeReport(false),
+	dumps(0)
+{
+}
+
+
+bool parseOptions(int argc, char* argv[], CompilerOptions& options)
+{
+	int positional = 0;
+	for (int i = 1; i < argc; i++)
+	{
+		string arg = argv[i];
+		if (arg == "--stream-tokens")
+		{
+			options.streamTokens = true;
+		}
+		else if (arg.compare(0, 9, "--object=") == 0)
+		{
+			options.objectFile = arg.substr(9);
+		}
+		else if (arg.compare(0, 9, "--target=") == 0)
+		{
+			options.targetFile = arg.substr(9);
+		}
+		else if (arg.compare(0, 7, "--regs=") == 0)
+		{
+			options.registers = arg.substr(7);
+		}
+		else if (arg == "--regalloc=graph")
+		{
+			options.allocator = RA_GRAPH_COLORING;
+		}
+		else if (arg == "--regalloc=linear-scan")
+		{
+			options.allocator = RA_LINEAR_SCAN;
+		}
+		else if (arg == "--schedule=none")
+		{
+			options.schedule = SCHED_NONE;
+		}
+		else if (arg == "--schedule=pre")
+		{
+			options.schedule = SCHED_PRE;
+		}
+		else if (arg == "--schedule=post")
+		{
+			options.schedule = SCHED_POST;
+		}
+		else if (arg == "--simulate")
+		{
+			options.simulate = true;
+		}
+		else if (arg.compare(0, 11, "--simulate=") == 0)
+		{
+			// samo pozitivan ceo broj u opsegu, bez znaka i razmaka
+			const char* text = arg.c_str() + 11;
+			char* end;
+			errno = 0;
+			long long steps = strtoll(text, &end, 10);
+			if (*text < '0' || *text > '9' || *end != '\0' || errno == ERANGE || steps <= 0)
+			{
+				cerr << "Invalid number of simulated instructions in: " << arg << endl;
+				return false;
+			}
+			options.simulate = true;
+			options.simulateSteps = steps;
+		}
+		else if (arg == "--time-report")
+		{
+			options.timeReport = true;
+		}
+		else if (arg.compare(0, 12, "--time-json=") == 0)
+		{
+			options.timeJson = arg.substr(12);
+		}
+		else if (arg.compare(0, 13, "--time-trace=") == 0)
+		{
+			options.timeTrace = arg.substr(13);
+		}
+		else if (arg.compare(0, 7, "--dump=") == 0)
+		{
+			if (!Dump::parseList(arg.substr(7), options.dumps))
+			{
+				cerr << "Unknown dump in: " << arg << endl;
+				return false;
+			}
+		}
+		else if (arg.compare(0, 12, "--dump-file=") == 0)
+		{
+			options.dumpFile = arg.substr(12);
+		}
+		else if (arg.size() > 1 && arg[0] == '-')
+		{
+			cerr << "Unknown option: " << arg << endl;
+			return false;
+		}
+		else if (positional == 0)
+		{
+			options.inputFile = arg;
+			positional++;
+		}
+		else if (positional == 1)
+		{
+			options.outputFile = arg;
+			positional++;
+		}
+		else
+		{
+			cerr << "Too many file names: " << arg << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+
+void printUsage(const char* programName)
+{
+	cout << "Usage: " << programName << " [options] [input.mavn [output.s]]\n"
+		<< "Options:\n"
+		<< "  --stream-tokens    parse while lexing, without building the token list\n"
+		<< "  --object=FILE      also write the code as a relocatable ELF32 MIPS object\n"
+		<< "  --target=FILE      read the allocatable registers from a target description\n"
+		<< "  --regs=LIST        comma separated allocatable registers (default $t0,$t1,$t2,$t3)\n"
+		<< "  --regalloc=KIND    register allocator: graph (default) or linear-scan\n"
+		<< "  --schedule=WHEN    schedule instructions and fill branch delay slots:\n"
+		<< "                     none (default), pre (before allocation) or post (after allocation)\n"
+		<< "  --simulate[=N]     run the generated code (at most N instructions, default 100000000)\n"
+		<< "                     and print instruction, memory access, branch and cycle counts\n"
+		<< "  --time-report      print wall time, CPU time, peak RSS growth and allocations of every phase\n"
+		<< "  --time-json=FILE   write the phase measurements as JSON\n"
+		<< "  --time-trace=FILE  write the phase measurements in Chrome trace event format\n"
+		<< "  --dump=LIST        comma separated debug dumps (nothing is dumped by default):\n"
+		<< "                     tokens, instructions, variables, cfg, liveness, graph, registers,\n"
+		<< "                     passes (optimization messages and statistics) or all\n"
+		<< "  --dump-file=FILE   write the debug dumps to FILE instead of the standard output\n";
+}
@@ -0,0 +1,47 @@
+#ifndef __OPTIONS__
+#define __OPTIONS__
+
+#include "Types.h"
+
+#include <string>
+
+
+/**
+ * Settings of one compilation, filled from the command line
+ */
+struct CompilerOptions
+{
+	CompilerOptions();
+
+	std::string inputFile;      // Path of the MAVN source file
+	std::string outputFile;     // Path of the generated assembly file
+	std::string objectFile;     // Path of the generated ELF object file (empty for none)
+	bool streamTokens;          // Parser pulls tokens from the lexer instead of walking a token list
+	std::string targetFile;     // Target description with the allocatable registers (empty for the default)
+	std::string registers;      // Comma separated allocatable registers, overrides the target file
+	RegAllocType allocator;     // Register allocation algorithm
+	ScheduleMode schedule;      // When instructions are scheduled (and delay slots filled)
+	bool simulate;              // Run the generated code in the simulator and print its counters
+	long long simulateSteps;    // Maximum number of simulated instructions
+	bool timeReport;            // Print the time and memory of every phase
+	std::string timeJson;       // File for the phase measurements as JSON (empty for none)
+	std::string timeTrace;      // File for the phase measurements as Chrome trace events (empty for none)
+	unsigned int dumps;         // Selected debug dumps (bitwise or of DumpKind values)
+	std::string dumpFile;       // File for the debug dumps (empty for the standard output)
+};
+
+/**
+ * Fills the options from the program arguments
+ *	usage: program [options] [input.mavn [output.s]]
+ * [in]  argc, argv - arguments of main
+ * [out] options - parsed options, fields not given keep their default values
+ * [out] return - false if an unknown option was given
+ */
+bool parseOptions(int argc, char* argv[], CompilerOptions& options);
+
+/**
+ * Prints the list of supported options
+ */
+void printUsage(const char* programName);
+
+#endif
@@ -0,0 +1,202 @@
+#include "Peephole.h"
+
+#include "ControlFlowGraph.h"
+
+// Tabela pravila, primenjuju se ovim redom
+const Peephole::RuleEntry Peephole::rules[] =
+{
+	{ "nop removal",                &Peephole::removeNop },
+	{ "self move removal",          &Peephole::removeSelfMove },
+	{ "branch to next removal",     &Peephole::removeBranchToNext },
+	{ "li + add/sub -> addi",       &Peephole::foldLoadImmediate },
+	{ "redundant load elimination", &Peephole::removeRedundantLoad }
+};
+
+const int Peephole::numRules = sizeof(rules) / sizeof(rules[0]);
+
+// Najveći broj instrukcija unazad koje se pregledaju pri traženju iste vrednosti u registru
+static const int REDUNDANT_LOAD_WINDOW = 32;
+
+Peephole::Peephole(SyntaxAnalysis& syntax) :
+	syntax(syntax), instrs(syntax.getInstructions()), matches(numRules, 0)
+{
+}
+
+// Primenjuje pravila redom, svako dok god ima poklapanja
+int Peephole::Do()
+{
+	int total = 0;
+	for (int r = 0; r < numRules; r++)
+	{
+		bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			for (Instructions::iterator it = instrs.begin(); it != instrs.end();)
+			{
+				if (!(*it)->isFunc() && (this->*rules[r].apply)(it))
+				{
+					++matches[r];
+					++total;
+					changed = true;
+				}
+				else
+				{
+					++it;
+				}
+			}
+		}
+	}
+	return total;
+}
+
+// Ispisuje broj primena svakog pravila
+void Peephole::printStatistics(std::ostream& out) const
+{
+	out << ">>>>>=====-----\n"
+		<< "| Peephole:\n"
+		<< ">>>>>=====-----\n";
+	for (int r = 0; r < numRules; r++)
+		out << "| " << rules[r].name << ": " << matches[r] << "\n";
+}
+
+// Uklanja nop
+bool Peephole::removeNop(Instructions::iterator& it)
+{
+	return (*it)->getType() == I_NOP && remove(it);
+}
+
+// Uklanja addi rX, rX, 0
+bool Peephole::removeSelfMove(Instructions::iterator& it)
+{
+	Instruction* in = *it;
+	if (in->getType() != I_ADDI || in->getSrc().back()->getValue() != 0)
+		return false;
+	if (in->getDst().front()->getAssignment() != in->getSrc().front()->getAssignment())
+		return false;
+	return remove(it);
+}
+
+// Uklanja skok na labelu sledeće instrukcije
+bool Peephole::removeBranchToNext(Instructions::iterator& it)
+{
+	Instruction* in = *it;
+	if (!isBranch(in->getType()))
+		return false;
+	Instructions::iterator next = it;
+	++next;
+	if (next == instrs.end() || (*next)->getLabel() != in->getSrc().back())
+		return false;
+	return remove(it);
+}
+
+// Spaja li rC, c i add/sub koji ga jedini koristi u addi
+bool Peephole::foldLoadImmediate(Instructions::iterator& it)
+{
+	Instruction* li = *it;
+	if (li->getType() != I_LI)
+		return false;
+	Instructions::iterator next = it;
+	++next;
+	if (next == instrs.end())
+		return false;
+	Instruction* op = *next;
+	if (op->getLabel() != nullptr || (op->getType() != I_ADD && op->getType() != I_SUB))
+		return false;
+
+	Variable* c = li->getDst().front();
+	Variable* a = op->getSrc().front();
+	Variable* b = op->getSrc().back();
+	Variable* d = op->getDst().front();
+	Variable* s;
+	int value = li->getSrc().front()->getValue();
+	if (b == c && a != c)
+		s = a;
+	else if (a == c && b != c && op->getType() == I_ADD)
+		s = b;
+	else
+		return false;
+	if (op->getType() == I_SUB)
+		value = -value;
+
+	// konstanta mora stati u 16 bita, a rC ne sme biti živ nakon add/sub
+	if (value < -32768 || value > 32767)
+		return false;
+	if (d != c && op->isLiveOut(c))
+		return false;
+
+	Instruction* addi = syntax.getContext().newInstruction(I_ADDI);
+	addi->addDst(d);
+	addi->addSrc(s);
+	addi->addSrc(syntax.constVariable(value));
+	if (li->getLabel() != nullptr)
+		addi->addLabel(li->getLabel());
+
+	instrs.insert(it, addi);
+	instrs.erase(next);
+	it = instrs.erase(it);
+	--it;
+	return true;
+}
+
+// Uklanja la/li/lw koji u registar učitava vrednost koju on već sadrži (unutar istog bloka)
+bool Peephole::removeRedundantLoad(Instructions::iterator& it)
+{
+	Instruction* in = *it;
+	InstructionType type = in->getType();
+	if (in->getLabel() != nullptr || (type != I_LA && type != I_LI && type != I_LW))
+		return false;
+
+	Regs reg = in->getDst().front()->getAssignment();
+	Regs base = type == I_LW ? in->getSrc().back()->getAssignment() : no_assign;
+
+	Instructions::iterator prev = it;
+	for (int n = 0; n < REDUNDANT_LOAD_WINDOW && prev != instrs.begin(); n++)
+	{
+		Instruction* p = *--prev;
+		if (p->isFunc() || endsBlock(p))
+			return false;
+
+		if (p->getType() == type && p->getDst().front()->getAssignment() == reg)
+		{
+			Operands& src = in->getSrc();
+			Operands& psrc = p->getSrc();
+			bool same = type == I_LW ?
+				src.front() == psrc.front() && psrc.back()->getAssignment() == base && base != reg :
+				src.front() == psrc.front();
+			return same && remove(it);
+		}
+
+		if (defines(p, reg) || (type == I_LW && (defines(p, base) || p->getType() == I_SW)))
+			return false;
+		if (p->getLabel() != nullptr)
+			return false;
+	}
+	return false;
+}
+
+// Uklanja instrukciju zadržavajući labelu
+bool Peephole::remove(Instructions::iterator& it)
+{
+	Instructions::iterator next = it;
+	++next;
+	if (!removeInstruction(instrs, it))
+		return false;
+	it = next;
+	return true;
+}
+
+// Proverava da li instrukcija upisuje u registar
+bool Peephole::defines(Instruction* in, Regs reg)
+{
+	for (Variable* v : in->getDst())
+		if (v->getType() == Variable::REG_VAR && v->getAssignment() == reg)
+			return true;
+	return false;
+}
+
+// Proverava da li se instrukcijom završava osnovni blok
+bool Peephole::endsBlock(Instruction* in)
+{
+	return isBranch(in->getType());
+}
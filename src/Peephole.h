@@ -0,0 +1,95 @@
+#ifndef __PEEPHOLE__
+#define __PEEPHOLE__
+
+#include "SyntaxAnalysis.h"
+
+
+/**
+ * Peephole optimizer over the allocated instruction list (runs after register allocation,
+ * so registers are compared by their assignment, not by variable).
+ *
+ * Rules are kept in a table and applied in table order, each one over the whole list until
+ * it stops matching. Rules which rely on the liveness computed before allocation come first;
+ * redundant load elimination makes two variables share one value, so it runs last.
+ */
+class Peephole
+{
+public:
+	/**
+	 * [in] syntax - owner of the instructions and constants
+	 */
+	Peephole(SyntaxAnalysis& syntax);
+
+	/**
+	 * Applies all rules
+	 * [out] return - number of removed or rewritten instructions
+	 */
+	int Do();
+
+	/**
+	 * Prints how many times every rule matched
+	 */
+	void printStatistics(std::ostream& out = std::cout) const;
+
+private:
+	/**
+	 * Rule applied at the instruction it points to. On a match the rule rewrites the list,
+	 * sets it to the instruction from which matching continues and returns true.
+	 */
+	typedef bool (Peephole::*Rule)(Instructions::iterator& it);
+
+	struct RuleEntry
+	{
+		const char* name;
+		Rule apply;
+	};
+
+	static const RuleEntry rules[];
+	static const int numRules;
+
+	/**
+	 * nop
+	 */
+	bool removeNop(Instructions::iterator& it);
+
+	/**
+	 * addi rX, rX, 0
+	 */
+	bool removeSelfMove(Instructions::iterator& it);
+
+	/**
+	 * b/bltz/bne to the label of the next instruction
+	 */
+	bool removeBranchToNext(Instructions::iterator& it);
+
+	/**
+	 * li rC, c; add/sub rD, rS, rC  ->  addi rD, rS, (+/-)c   when rC dies at the add/sub
+	 */
+	bool foldLoadImmediate(Instructions::iterator& it);
+
+	/**
+	 * la/li/lw which loads the value the register already holds in the same basic block
+	 */
+	bool removeRedundantLoad(Instructions::iterator& it);
+
+	/**
+	 * Removes the instruction keeping its label, it is set to the next instruction
+	 */
+	bool remove(Instructions::iterator& it);
+
+	/**
+	 * Returns true if the instruction writes the register
+	 */
+	static bool defines(Instruction* in, Regs reg);
+
+	/**
+	 * Returns true if the instruction ends a basic block
+	 */
+	static bool endsBlock(Instruction* in);
+
+	SyntaxAnalysis& syntax;
+	Instructions& instrs;
+	std::vector<int> matches;       // Number of matches of every rule
+};
+
+#endif
@@ -0,0 +1,337 @@
+#include "Scheduler.h"
+
+#include "ControlFlowGraph.h"
+
+#include <algorithm>
+#include <queue>
+#include <stdexcept>
+
+// Najveći broj instrukcija ispred skoka koje se razmatraju za delay slot
+static const int DELAY_SLOT_WINDOW = 16;
+
+// Tabela kašnjenja: broj ciklusa nakon izdavanja posle kojih je rezultat dostupan. Rezultat
+// ALU instrukcije se prosleđuje iz EX faze sledećoj instrukciji, a lw ima podatak tek nakon MEM faze
+static const struct
+{
+	InstructionType type;
+	int latency;
+} latencyTable[] =
+{
+	{ I_ADD, 1 },
+	{ I_ADDI, 1 },
+	{ I_SUB, 1 },
+	{ I_AND, 1 },
+	{ I_OR, 1 },
+	{ I_NOT, 1 },   // nor sa $zero
+	{ I_LA, 1 },    // lui + addiu, rezultat daje addiu i prosleđuje se kao i kod ostalih ALU instrukcija
+	{ I_LI, 1 },    // addiu, ori ili lui + ori
+	{ I_LW, 2 },    // jedan ciklus čekanja između učitavanja i upotrebe
+	{ I_SW, 1 },    // nema rezultat
+	{ I_B, 1 },     // skokovi nemaju rezultat, njihovo kašnjenje pokriva delay slot
+	{ I_BLTZ, 1 },
+	{ I_BNE, 1 },
+	{ I_NOP, 1 }
+};
+
+Scheduler::Scheduler(SyntaxAnalysis& syntax, bool allocated) :
+	context(syntax.getContext()), instrs(syntax.getInstructions()), allocated(allocated),
+	stallsBefore(0), stallsAfter(0), filledSlots(0), nopSlots(0)
+{
+}
+
+// Vraća kašnjenje rezultata instrukcije
+int Scheduler::latency(InstructionType type)
+{
+	for (unsigned int i = 0; i < sizeof(latencyTable) / sizeof(latencyTable[0]); i++)
+		if (latencyTable[i].type == type)
+			return latencyTable[i].latency;
+	return 1;
+}
+
+// Vraća ključ po kome se porede registarski operandi
+long long Scheduler::key(Variable* var) const
+{
+	return allocated ? (long long)var->getAssignment() : (long long)(size_t)var;
+}
+
+// Raspoređuje instrukcije unutar svakog osnovnog bloka
+void Scheduler::schedule()
+{
+	Instructions::iterator it = instrs.begin();
+	while (it != instrs.end())
+	{
+		if ((*it)->isFunc())
+		{
+			++it;
+			continue;
+		}
+
+		// blok ide od labele ili instrukcije nakon skoka do sledećeg skoka ili labele
+		Instructions::iterator begin = it;
+		std::vector<Instruction*> block;
+		while (it != instrs.end() && !isBranch((*it)->getType()) && (it == begin || (*it)->getLabel() == nullptr))
+			block.push_back(*it++);
+
+		if (block.size() > 1)
+		{
+			stallsBefore += stallCycles(block);
+			std::vector<Instruction*> order = scheduleBlock(block);
+			stallsAfter += stallCycles(order);
+
+			// labela bloka ostaje na prvoj instrukciji
+			Variable* label = block.front()->getLabel();
+			if (label != nullptr && order.front() != block.front())
+			{
+				block.front()->removeLabel();
+				order.front()->addLabel(label);
+			}
+			Instructions::iterator out = begin;
+			for (Instruction* in : order)
+				*out++ = in;
+		}
+
+		if (it != instrs.end() && isBranch((*it)->getType()))
+			++it;
+	}
+}
+
+// Raspoređuje instrukcije jednog bloka po najdužem putu do kraja bloka
+std::vector<Instruction*> Scheduler::scheduleBlock(const std::vector<Instruction*>& block)
+{
+	int n = (int)block.size();
+	std::vector<std::vector<std::pair<int, int>>> succ(n);     // (sledbenik, kašnjenje)
+	std::vector<int> preds(n, 0);
+
+	auto addEdge = [&succ, &preds](int from, int to, int delay)
+	{
+		succ[from].push_back(std::make_pair(to, delay));
+		++preds[to];
+	};
+
+	std::unordered_map<long long, int> lastDef;
+	std::unordered_map<long long, std::vector<int>> usesSinceDef;
+	int lastStore = -1;
+	std::vector<int> loadsSinceStore;
+
+	for (int i = 0; i < n; i++)
+	{
+		Instruction* in = block[i];
+		for (Variable* v : in->getSrc())
+		{
+			if (v->getType() != Variable::REG_VAR)
+				continue;
+			long long k = key(v);
+			std::unordered_map<long long, int>::iterator def = lastDef.find(k);
+			if (def != lastDef.end())
+				addEdge(def->second, i, latency(block[def->second]->getType()));
+			usesSinceDef[k].push_back(i);
+		}
+		for (Variable* v : in->getDst())
+		{
+			if (v->getType() != Variable::REG_VAR)
+				continue;
+			long long k = key(v);
+			std::unordered_map<long long, int>::iterator def = lastDef.find(k);
+			if (def != lastDef.end())
+				addEdge(def->second, i, 1);
+			for (int u : usesSinceDef[k])
+				if (u != i)
+					addEdge(u, i, 1);
+			usesSinceDef[k].clear();
+			lastDef[k] = i;
+		}
+
+		if (in->getType() == I_LW)
+		{
+			if (lastStore != -1)
+				addEdge(lastStore, i, 1);
+			loadsSinceStore.push_back(i);
+		}
+		else if (in->getType() == I_SW)
+		{
+			if (lastStore != -1)
+				addEdge(lastStore, i, 1);
+			for (int l : loadsSinceStore)
+				addEdge(l, i, 1);
+			loadsSinceStore.clear();
+			lastStore = i;
+		}
+	}
+
+	// prioritet je najduži put (zbir kašnjenja) do kraja bloka
+	std::vector<int> priority(n, 0);
+	for (int i = n - 1; i >= 0; i--)
+	{
+		priority[i] = latency(block[i]->getType());
+		for (std::pair<int, int>& s : succ[i])
+			priority[i] = std::max(priority[i], s.second + priority[s.first]);
+	}
+
+	// pending: spremne po zavisnostima, čekaju ciklus; available: mogu da se izdaju
+	typedef std::pair<int, int> Entry;
+	auto byPriority = [&priority](const Entry& a, const Entry& b)
+	{
+		return priority[a.second] != priority[b.second] ? priority[a.second] < priority[b.second] : a.second > b.second;
+	};
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pending;   // (najraniji ciklus, čvor)
+	std::priority_queue<Entry, std::vector<Entry>, decltype(byPriority)> available(byPriority);
+	std::vector<int> earliest(n, 0);
+	for (int i = 0; i < n; i++)
+		if (preds[i] == 0)
+			pending.push(std::make_pair(0, i));
+
+	std::vector<Instruction*> order;
+	order.reserve(n);
+	int cycle = 0;
+	while ((int)order.size() < n)
+	{
+		while (!pending.empty() && pending.top().first <= cycle)
+		{
+			available.push(pending.top());
+			pending.pop();
+		}
+		if (available.empty())
+		{
+			cycle = pending.top().first;
+			continue;
+		}
+
+		int i = available.top().second;
+		available.pop();
+		order.push_back(block[i]);
+		for (std::pair<int, int>& s : succ[i])
+		{
+			earliest[s.first] = std::max(earliest[s.first], cycle + s.second);
+			if (--preds[s.first] == 0)
+				pending.push(std::make_pair(earliest[s.first], s.first));
+		}
+		++cycle;
+	}
+	return order;
+}
+
+// Broji cikluse čekanja na operande kada se instrukcije izdaju datim redom
+int Scheduler::stallCycles(const std::vector<Instruction*>& block)
+{
+	std::unordered_map<long long, int> ready;
+	int cycle = 0;
+	int stalls = 0;
+	for (Instruction* in : block)
+	{
+		int issue = cycle;
+		for (Variable* v : in->getSrc())
+			if (v->getType() == Variable::REG_VAR)
+			{
+				std::unordered_map<long long, int>::iterator r = ready.find(key(v));
+				if (r != ready.end())
+					issue = std::max(issue, r->second);
+			}
+		stalls += issue - cycle;
+		for (Variable* v : in->getDst())
+			if (v->getType() == Variable::REG_VAR)
+				ready[key(v)] = issue + latency(in->getType());
+		cycle = issue + 1;
+	}
+	return stalls;
+}
+
+// Proverava da li instrukcije moraju ostati u datom redosledu
+bool Scheduler::dependent(Instruction* first, Instruction* second)
+{
+	for (Variable* d : first->getDst())
+	{
+		if (d->getType() != Variable::REG_VAR)
+			continue;
+		for (Variable* v : second->getSrc())
+			if (v->getType() == Variable::REG_VAR && key(v) == key(d))
+				return true;
+		for (Variable* v : second->getDst())
+			if (v->getType() == Variable::REG_VAR && key(v) == key(d))
+				return true;
+	}
+	for (Variable* u : first->getSrc())
+	{
+		if (u->getType() != Variable::REG_VAR)
+			continue;
+		for (Variable* v : second->getDst())
+			if (v->getType() == Variable::REG_VAR && key(v) == key(u))
+				return true;
+	}
+	bool firstMemory = first->getType() == I_LW || first->getType() == I_SW;
+	bool secondMemory = second->getType() == I_LW || second->getType() == I_SW;
+	return firstMemory && secondMemory && (first->getType() == I_SW || second->getType() == I_SW);
+}
+
+// Popunjava delay slot svakog skoka nezavisnom instrukcijom iz istog bloka ili sa nop
+void Scheduler::fillDelaySlots()
+{
+	// prva instrukcija iza delay slota prethodnog skoka, ispod nje se ne traži
+	Instructions::iterator first = instrs.begin();
+	for (Instructions::iterator it = instrs.begin(); it != instrs.end(); ++it)
+	{
+		Instruction* branch = *it;
+		if (!isBranch(branch->getType()))
+			continue;
+
+		// traži se unazad do početka bloka instrukcija od koje ne zavisi ništa do skoka,
+		// kandidat ne sme preći labelu (ni labelu samog skoka) jer bi se izvršavao i na putanji kroz nju
+		Instructions::iterator candidate = instrs.end();
+		Instructions::iterator prev = it;
+		for (int n = 0; n < DELAY_SLOT_WINDOW && prev != first && (*prev)->getLabel() == nullptr; n++)
+		{
+			--prev;
+			Instruction* in = *prev;
+			if (in->isFunc() || isBranch(in->getType()) || in->getLabel() != nullptr)
+				break;
+
+			bool movable = true;
+			Instructions::iterator later = prev;
+			for (++later; movable && later != it; ++later)
+				movable = !dependent(in, *later);
+			if (movable && !dependent(in, branch))
+			{
+				candidate = prev;
+				break;
+			}
+		}
+
+		Instructions::iterator slot = it;
+		++slot;
+		if (candidate != instrs.end())
+		{
+			Instruction* in = *candidate;
+			instrs.erase(candidate);
+			instrs.insert(slot, in);
+			++filledSlots;
+		}
+		else
+		{
+			instrs.insert(slot, context.newInstruction(I_NOP));
+			++nopSlots;
+		}
+		++it;
+		first = it;
+		++first;
+	}
+
+	// nijedan skok ne sme završiti u delay slotu drugog skoka
+	for (Instructions::iterator it = instrs.begin(); it != instrs.end(); ++it)
+	{
+		if (!isBranch((*it)->getType()))
+			continue;
+		Instructions::iterator slot = it;
+		if (++slot == instrs.end() || isBranch((*slot)->getType()))
+			throw std::runtime_error("\nException! Branch without a delay slot after scheduling!\n");
+		it = slot;
+	}
+}
+
+// Ispisuje procenjene cikluse čekanja i broj popunjenih delay slotova
+void Scheduler::printStatistics(std::ostream& out) const
+{
+	out << ">>>>>=====-----\n"
+		<< "| Scheduling (" << (allocated ? "after" : "before") << " allocation):\n"
+		<< ">>>>>=====-----\n"
+		<< "| load-use stall cycles: " << stallsBefore << " -> " << stallsAfter << "\n"
+		<< "| delay slots: " << filledSlots << " filled, " << nopSlots << " nop\n";
+}
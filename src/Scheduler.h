@@ -0,0 +1,94 @@
+#ifndef __SCHEDULER__
+#define __SCHEDULER__
+
+#include "SyntaxAnalysis.h"
+
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * List scheduler for the classic MIPS pipeline.
+ *
+ * Every basic block (from a label or a branch to the next branch) gets a dependency DAG built
+ * from the destinations and sources of its instructions: read after write edges carry the
+ * latency of the producer from the latency table, write after read, write after write and
+ * memory ordering (sw against lw/sw) edges only keep the order. Instructions are issued one
+ * per cycle, highest critical path first, and an instruction is not issued before its
+ * operands are ready. The branch stays last and the block label stays on the first instruction.
+ *
+ * The latency table lists every instruction of the language. On the classic five stage
+ * pipeline with forwarding only lw has a latency above one: its value is known after the MEM
+ * stage, so a use in the next instruction waits one cycle. Every ALU result (including the
+ * last instruction of the la and li expansions) is forwarded to the next instruction, and the
+ * language has no multi-cycle operations (mult/div with HI/LO). The simulator counts stalls by
+ * the same model.
+ *
+ * Before allocation dependencies are between variables, after allocation between registers.
+ * Delay slot filling runs after allocation in both modes and must be the last change of the
+ * code: the instruction after a branch executes whether the branch is taken or not, so the
+ * result is emitted with .set noreorder.
+ */
+class Scheduler
+{
+public:
+	/**
+	 * [in] syntax    - owner of the instructions
+	 * [in] allocated - true if registers are already assigned (dependencies between registers)
+	 */
+	Scheduler(SyntaxAnalysis& syntax, bool allocated);
+
+	/**
+	 * Reorders instructions inside every basic block
+	 */
+	void schedule();
+
+	/**
+	 * Moves an independent instruction from before every b/bltz/bne into its delay slot,
+	 * or puts a nop there if there is none. The instruction never moves past a label or out
+	 * of the previous delay slot; throws runtime_error if a branch ends up in a delay slot
+	 */
+	void fillDelaySlots();
+
+	/**
+	 * Prints estimated stall cycles before and after scheduling and the number of filled slots
+	 */
+	void printStatistics(std::ostream& out = std::cout) const;
+
+	/**
+	 * Returns the number of cycles after issue when the result of the instruction can be used
+	 */
+	static int latency(InstructionType type);
+
+private:
+	/**
+	 * Schedules the instructions of one block (without the closing branch)
+	 * [out] return - the instructions in the new order
+	 */
+	std::vector<Instruction*> scheduleBlock(const std::vector<Instruction*>& block);
+
+	/**
+	 * Returns the number of stall cycles of the instructions issued in the given order
+	 */
+	int stallCycles(const std::vector<Instruction*>& block);
+
+	/**
+	 * Returns true if the order of the two instructions can't be swapped
+	 */
+	bool dependent(Instruction* first, Instruction* second);
+
+	/**
+	 * Returns the key by which register operands are compared (variable or assigned register)
+	 */
+	long long key(Variable* var) const;
+
+	CompilationContext& context;
+	Instructions& instrs;
+	bool allocated;
+	int stallsBefore;
+	int stallsAfter;
+	int filledSlots;
+	int nopSlots;
+};
+
+#endif
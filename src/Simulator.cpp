@@ -0,0 +1,193 @@
+#include "Simulator.h"
+
+#include "ControlFlowGraph.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+
+Simulator::Simulator(SyntaxAnalysis& syntax, bool delaySlots) :
+	mem_vars(syntax.getMem()), delaySlots(delaySlots),
+	instructions(0), loads(0), stores(0), branches(0), takenBranches(0), stalls(0)
+{
+	int numRegs = 0;
+	for (Instruction* in : syntax.getInstructions())
+	{
+		if (in->isFunc())
+		{
+			labels[in->getLabel()] = (int)code.size();
+			continue;
+		}
+		if (in->getLabel() != nullptr)
+			labels[in->getLabel()] = (int)code.size();
+		code.push_back(in);
+
+		for (Variable* v : in->getDst())
+			if (v->getType() == Variable::REG_VAR)
+				numRegs = std::max(numRegs, (int)v->getAssignment());
+		for (Variable* v : in->getSrc())
+			if (v->getType() == Variable::REG_VAR)
+				numRegs = std::max(numRegs, (int)v->getAssignment());
+	}
+	registers.assign(numRegs + 1, 0);
+
+	unsigned int address = DATA_BASE;
+	for (Variable* v : mem_vars)
+	{
+		addresses[v] = address;
+		memory.push_back(v->getValue());
+		address += 4;
+	}
+}
+
+// Vraća indeks registra operanda
+int Simulator::reg(Variable* var) const
+{
+	return var->getAssignment();
+}
+
+// Vraća indeks memorijske reči na adresi
+unsigned int Simulator::word(unsigned int address) const
+{
+	if (address % 4 != 0 || address < DATA_BASE || (address - DATA_BASE) / 4 >= memory.size())
+	{
+		char text[16];
+		snprintf(text, sizeof(text), "0x%08x", address);
+		throw std::runtime_error("\nException! Simulator: invalid memory access at " + std::string(text) + "!\n");
+	}
+	return (address - DATA_BASE) / 4;
+}
+
+// Izvršava program
+void Simulator::run(long long maxSteps)
+{
+	int pc = 0;
+	int npc = 1;
+	int loadedReg = -1;     // registar koji je upisala prethodna lw instrukcija
+
+	while (pc < (int)code.size())
+	{
+		if (instructions >= maxSteps)
+			throw std::runtime_error("\nException! Simulator: more than " + std::to_string(maxSteps) + " instructions executed!\n");
+
+		Instruction* in = code[pc];
+		Operands& src = in->getSrc();
+		Variable* a = src.empty() ? nullptr : src.front();
+		Variable* b = src.empty() ? nullptr : src.back();
+		Variable* d = in->getDst().empty() ? nullptr : in->getDst().front();
+		++instructions;
+
+		// upotreba rezultata lw odmah u sledećoj instrukciji čeka jedan ciklus
+		if (loadedReg != -1)
+			for (Variable* v : src)
+				if (v->getType() == Variable::REG_VAR && reg(v) == loadedReg)
+				{
+					++stalls;
+					break;
+				}
+		loadedReg = -1;
+
+		int target = -1;
+		switch (in->getType())
+		{
+		case I_ADD:
+			registers[reg(d)] = (int)((unsigned int)registers[reg(a)] + (unsigned int)registers[reg(b)]);
+			break;
+		case I_ADDI:
+			registers[reg(d)] = (int)((unsigned int)registers[reg(a)] + (unsigned int)b->getValue());
+			break;
+		case I_SUB:
+			registers[reg(d)] = (int)((unsigned int)registers[reg(a)] - (unsigned int)registers[reg(b)]);
+			break;
+		case I_AND:
+			registers[reg(d)] = registers[reg(a)] & registers[reg(b)];
+			break;
+		case I_OR:
+			registers[reg(d)] = registers[reg(a)] | registers[reg(b)];
+			break;
+		case I_NOT:
+			registers[reg(d)] = ~registers[reg(a)];
+			break;
+		case I_LA:
+			registers[reg(d)] = (int)addresses[a];
+			break;
+		case I_LI:
+			registers[reg(d)] = a->getValue();
+			break;
+		case I_LW:
+			registers[reg(d)] = memory[word((unsigned int)registers[reg(b)] + (unsigned int)a->getValue())];
+			loadedReg = reg(d);
+			++loads;
+			break;
+		case I_SW:
+		{
+			Operands::iterator it = src.begin();
+			Variable* value = *it++;
+			Variable* offset = *it++;
+			Variable* base = *it;
+			memory[word((unsigned int)registers[reg(base)] + (unsigned int)offset->getValue())] = registers[reg(value)];
+			++stores;
+			break;
+		}
+		case I_B:
+			target = labels.at(b);
+			break;
+		case I_BLTZ:
+			if (registers[reg(a)] < 0)
+				target = labels.at(b);
+			break;
+		case I_BNE:
+		{
+			Operands::iterator it = src.begin();
+			Variable* first = *it++;
+			Variable* second = *it;
+			if (registers[reg(first)] != registers[reg(second)])
+				target = labels.at(b);
+			break;
+		}
+		default:
+			break;
+		}
+
+		if (isBranch(in->getType()))
+		{
+			++branches;
+			if (target != -1)
+				++takenBranches;
+		}
+
+		// sa delay slotovima se instrukcija nakon skoka izvršava pre prelaska na cilj
+		if (delaySlots)
+		{
+			pc = npc;
+			npc = target != -1 ? target : npc + 1;
+		}
+		else
+		{
+			pc = target != -1 ? target : pc + 1;
+			npc = pc + 1;
+		}
+	}
+}
+
+// Vraća vrednost memorijske promenljive
+int Simulator::getMemory(Variable* var) const
+{
+	return memory[(addresses.at(var) - DATA_BASE) / 4];
+}
+
+// Ispisuje brojače i krajnje vrednosti memorijskih promenljivih
+void Simulator::printStatistics(std::ostream& out)
+{
+	long long cycles = 4 + instructions + stalls + (delaySlots ? 0 : branches);
+	out << ">>>>>=====-----\n"
+		<< "| Simulation:\n"
+		<< ">>>>>=====-----\n"
+		<< "| instructions:     " << instructions << "\n"
+		<< "| loads / stores:   " << loads << " / " << stores << "\n"
+		<< "| branches (taken): " << branches << " (" << takenBranches << ")\n"
+		<< "| load-use stalls:  " << stalls << "\n"
+		<< "| estimated cycles: " << cycles << "\n";
+	for (Variable* v : mem_vars)
+		out << "| " << v->getName() << " = " << getMemory(v) << "\n";
+}
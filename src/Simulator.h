@@ -0,0 +1,77 @@
+#ifndef __SIMULATOR__
+#define __SIMULATOR__
+
+#include "SyntaxAnalysis.h"
+
+#include <unordered_map>
+#include <vector>
+
+
+/**
+ * Interpreter of the allocated instruction list with a simple cycle model of the classic
+ * five stage MIPS pipeline.
+ *
+ * Registers are the assigned ones (Variable::getAssignment), memory variables are laid out as
+ * consecutive words of the .data segment starting at DATA_BASE with their initial values.
+ * Execution starts after the function label and ends when it runs past the last instruction
+ * (the jr $ra of the emitted code). Arithmetic wraps around like addu/subu.
+ *
+ * Estimated cycles = 4 (pipeline fill) + executed instructions + load-use stalls
+ *                    + one nop per branch when delay slots are left to the assembler.
+ */
+class Simulator
+{
+public:
+	/**
+	 * [in] syntax     - owner of the instructions and memory variables
+	 * [in] delaySlots - the code has filled delay slots (instruction after a branch always executes)
+	 */
+	Simulator(SyntaxAnalysis& syntax, bool delaySlots);
+
+	/**
+	 * Executes the program
+	 * [in] maxSteps - maximum number of executed instructions
+	 * throws runtime_error on an invalid memory access or when maxSteps is exceeded
+	 */
+	void run(long long maxSteps);
+
+	/**
+	 * Returns the value of the memory variable after the run
+	 */
+	int getMemory(Variable* var) const;
+
+	/**
+	 * Prints counters and the final values of memory variables
+	 */
+	void printStatistics(std::ostream& out = std::cout);
+
+	static const unsigned int DATA_BASE = 0x10010000;
+
+private:
+	/**
+	 * Returns the register index of the operand
+	 */
+	int reg(Variable* var) const;
+
+	/**
+	 * Returns the index of the memory word at the address, throws if it isn't a data word
+	 */
+	unsigned int word(unsigned int address) const;
+
+	Variables& mem_vars;
+	std::vector<Instruction*> code;
+	std::unordered_map<Variable*, int> labels;          // Index of the instruction with the label
+	std::unordered_map<Variable*, unsigned int> addresses;
+	std::vector<int> memory;
+	std::vector<int> registers;
+	bool delaySlots;
+
+	long long instructions;
+	long long loads;
+	long long stores;
+	long long branches;
+	long long takenBranches;
+	long long stalls;
+};
+
+#endif
@@ -4,31 +4,27 @@
 #include "Token.h"
 #include "IR.h"
 
-//  Konstruktor klase SyntaxAnalysis. Inicijalizuje promenljive i postavlja pokazivač na početak niske tokena.
-SyntaxAnalysis::SyntaxAnalysis(LexicalAnalysis& lexer) :
-	lex(lexer), currentToken(lexer.getTokenList().begin()),
-	instrs(), reg_vars(), mem_vars(), label_vars(), const_vars(),
-	err(false), eof(false), next_instruction_has_label(false) {}
+#include <stdexcept>
 
-// Destruktor klase SyntaxAnalysis. Oslobađa resurse alocirane za promenljive i instrukcije.
-SyntaxAnalysis::~SyntaxAnalysis()
-{
-	for (Variables::iterator it = reg_vars.begin(); it != reg_vars.end(); ++it)
-		delete* it;
-	for (Variables::iterator it = mem_vars.begin(); it != mem_vars.end(); ++it)
-		delete* it;
-	for (Variables::iterator it = label_vars.begin(); it != label_vars.end(); ++it)
-		delete* it;
-	for (Variables::iterator it = const_vars.begin(); it != const_vars.end(); ++it)
-		delete* it;
-	for (Instructions::iterator it = instrs.begin(); it != instrs.end(); ++it)
-		delete* it;
-}
+//  Konstruktor klase SyntaxAnalysis. Inicijalizuje promenljive, tokeni se čitaju od početka u metodi Do.
+SyntaxAnalysis::SyntaxAnalysis(LexicalAnalysis& lexer, CompilationContext& context, bool streamTokens) :
+	lex(lexer), streamTokens(streamTokens), tokenIndex(0), currentToken(), context(context),
+	instrs(context.getInstructions()), reg_vars(context.getRegs()), mem_vars(context.getMem()),
+	label_vars(context.getLabels()), const_vars(context.getConsts()), symbols(context.getSymbols()), next_label(nullptr),
+	err(false), eof(false), next_instruction_has_label(false) {}
 
 // Metoda koja pokreće sintaksnu analizu. Proverava tokene i poziva odgovarajuće metode za obradu instrukcija.
 bool SyntaxAnalysis::Do()
 {
-	currentToken = lex.getTokenList().begin();
+	if (streamTokens)
+	{
+		pullToken();
+	}
+	else
+	{
+		tokenIndex = 0;
+		currentToken = lex.getTokenList().empty() ? Token() : lex.getTokenList()[0];
+	}
 
 	Q();
 	checkLabels();
@@ -38,23 +34,23 @@ bool SyntaxAnalysis::Do()
 }
 
 // Metoda za ispis instrukcija.
-void SyntaxAnalysis::printInstructions()
+void SyntaxAnalysis::printInstructions(std::ostream& out)
 {
-	std::cout << ">>>>>======------\n"
+	out << ">>>>>======------\n"
 		<< "| Instructions :\n"
 		<< ">>>>>======------\n";
-	print(instrs);
+	print(instrs, out);
 }
 
 // Metoda za ispis promenljivih.
-void SyntaxAnalysis::printVariables()
+void SyntaxAnalysis::printVariables(std::ostream& out)
 {
-	std::cout << ">>>>>=====-----\n"
+	out << ">>>>>=====-----\n"
 		<< "|  Variables : \n"
 		<< ">>>>>=====-----\n";
-	print(mem_vars);
-	print(reg_vars);
-	print(const_vars);
+	print(mem_vars, out);
+	print(reg_vars, out);
+	print(const_vars, out);
 }
 
 // Metoda koja vraća referencu na registre.
@@ -75,6 +71,20 @@ Instructions& SyntaxAnalysis::getInstructions()
 	return instrs;
 }
 
+// Metoda koja vraća prevođenje koje poseduje promenljive i instrukcije.
+CompilationContext& SyntaxAnalysis::getContext()
+{
+	return context;
+}
+
+// Metoda koja kreira novu labelu za kod generisan optimizacijama.
+Variable* SyntaxAnalysis::newLabel(const std::string& prefix)
+{
+	Variable* var = context.newVariable(Variable::LABEL_VAR, prefix + "_" + std::to_string(label_vars.size()), 1);
+	label_vars.push_back(var);
+	return var;
+}
+
 // Metoda koja konzumira očekivani token. U slučaju da token nije očekivani tip, baca izuzetak.
 void SyntaxAnalysis::eat(TokenType token)
 {
@@ -83,71 +93,94 @@ void SyntaxAnalysis::eat(TokenType token)
 		eof = true;
 	}
 
-	if (currentToken->getType() == token)
+	if (currentToken.getType() == token)
 	{
-		++currentToken;
+		advance();
 	}
 	else {
 		err = true;
 		std::cerr << "Expected token is " <<
 			tokenTypeToString(token) << " but " <<
-			tokenTypeToString(currentToken->getType()) << " was given!" << std::endl;
+			tokenTypeToString(currentToken.getType()) << " was given!" << std::endl;
 		throw WRONG_TOKEN;
 	}
 }
 
+// Metoda koja učitava sledeći token iz liste ili, u režimu strujanja, direktno od leksera.
+void SyntaxAnalysis::advance()
+{
+	if (currentToken.getType() == T_END_OF_FILE)
+		return;
+
+	if (streamTokens)
+	{
+		pullToken();
+	}
+	else
+	{
+		TokenList& tokens = lex.getTokenList();
+		if (tokenIndex + 1 < tokens.size())
+			currentToken = tokens[++tokenIndex];
+	}
+}
+
+// Metoda koja u režimu strujanja uzima sledeći token od leksera. Leksička greška se prijavljuje
+// kao i kada se tokeni čitaju iz liste.
+void SyntaxAnalysis::pullToken()
+{
+	currentToken = lex.nextToken();
+	if (currentToken.getType() == T_ERROR)
+	{
+		err = true;
+		lex.printLexError();
+		throw std::runtime_error("\nException! Lexical analysis failed!\n");
+	}
+}
+
 // Metoda koja proverava tip sledećeg tokena. U slučaju da tip tokena nije očekivan, baca izuzetak.
 void SyntaxAnalysis::glance(TokenType token)
 {
-	if (token != currentToken->getType())
+	if (token != currentToken.getType())
 	{
 		err = true;
 		std::cerr << "Wrong token type " <<
-			tokenTypeToString(currentToken->getType()) <<
+			tokenTypeToString(currentToken.getType()) <<
 			", unable to read its contents for conversion!" << std::endl;
 		throw WRONG_TOKEN;
 	}
 }
 
 // Metoda koja proverava postojanje registarske promenljive sa datim imenom.
-void SyntaxAnalysis::regVariableExists(std::string& name)
+void SyntaxAnalysis::regVariableExists(int nameId)
 {
-	for (Variables::iterator it = reg_vars.begin(); it != reg_vars.end(); ++it)
+	if (symbols.find(Variable::REG_VAR, nameId) != nullptr)
 	{
-		if ((*it)->getName() == name)
-		{
-			err = true;
-			std::cerr << "Register variable with the same name already exists!" << std::endl;
-			throw REGISTER_VAR_EXISTS;
-		}
+		err = true;
+		std::cerr << "Register variable with the same name already exists!" << std::endl;
+		throw REGISTER_VAR_EXISTS;
 	}
 }
 
 // Metoda koja proverava postojanje memorijske promenljive sa datim imenom.
-void SyntaxAnalysis::memVariableExists(std::string& name)
+void SyntaxAnalysis::memVariableExists(int nameId)
 {
-	for (Variables::iterator it = mem_vars.begin(); it != mem_vars.end(); ++it)
+	if (symbols.find(Variable::MEM_VAR, nameId) != nullptr)
 	{
-		if ((*it)->getName() == name)
-		{
-			err = true;
-			std::cerr << "Memory variable with the same name already exists!" << std::endl;
-			throw MEMORY_VAR_EXISTS;
-		}
+		err = true;
+		std::cerr << "Memory variable with the same name already exists!" << std::endl;
+		throw MEMORY_VAR_EXISTS;
 	}
 }
 
-// Metoda koja proverava postojanje labele sa datim imenom.
-void SyntaxAnalysis::labelExists(std::string& name)
+// Metoda koja proverava da li je labela sa datim imenom već definisana.
+void SyntaxAnalysis::labelExists(int nameId)
 {
-	for (Variables::iterator it = label_vars.begin(); it != label_vars.end(); ++it)
+	Variable* label = symbols.find(Variable::LABEL_VAR, nameId);
+	if (label != nullptr && label->getValue() == 1)
 	{
-		if ((*it)->getName() == name && (*it)->getValue() == 1)
-		{
-			err = true;
-			std::cerr << "Label with the same name already exists!" << std::endl;
-			throw LABEL_EXISTS;
-		}
+		err = true;
+		std::cerr << "Label with the same name already exists!" << std::endl;
+		throw LABEL_EXISTS;
 	}
 }
 
@@ -156,33 +189,35 @@ Variable* SyntaxAnalysis::createVariable()
 {
 	Variable* var;
 	std::string name;
-	switch (currentToken->getType())
+	int nameId = currentToken.getNameId();
+	switch (currentToken.getType())
 	{
 	case T_M_ID:
-		name = currentToken->getValue();
-		memVariableExists(name);
+		name = currentToken.getValue().str();
+		memVariableExists(nameId);
 		eat(T_M_ID);
 
 		glance(T_NUM);
-		var = new Variable(Variable::MEM_VAR, name, stoi(currentToken->getValue()));
+		var = context.newVariable(Variable::MEM_VAR, name, currentToken.getValue().toInt());
+		symbols.insert(Variable::MEM_VAR, nameId, var);
 		eat(T_NUM);
 
 		break;
 	case T_R_ID:
-		name = currentToken->getValue();
-		regVariableExists(name);
+		name = currentToken.getValue().str();
+		regVariableExists(nameId);
 		eat(T_R_ID);
 
-		var = new Variable(Variable::REG_VAR, name);
+		var = context.newVariable(Variable::REG_VAR, name);
+		symbols.insert(Variable::REG_VAR, nameId, var);
 
 		break;
 	case T_ID:
-		name = currentToken->getValue();
-		labelExists(name);
+		labelExists(nameId);
+		var = findLabel();
+		var->getValue() = 1;
 		eat(T_ID);
 
-		var = new Variable(Variable::LABEL_VAR, name, 1);
-
 		break;
 	default:
 		err = true;
@@ -192,53 +227,50 @@ Variable* SyntaxAnalysis::createVariable()
 	return var;
 }
 
-// Metoda koja pronalazi promenljivu na osnovu imena.
+// Metoda koja pronalazi registarsku ili memorijsku promenljivu na osnovu imena trenutnog tokena.
 Variable* SyntaxAnalysis::findVariable()
 {
-	return findVariable(currentToken->getValue());
-}
-
-// Metoda koja kreira konstantnu promenljivu sa zadatom vrednošću.
-Variable* SyntaxAnalysis::constVariable(int value)
-{
-	return findVariable("c" + std::to_string(value));
-}
-
-// Metoda koja pronalazi promenljivu na osnovu imena.
-Variable* SyntaxAnalysis::findVariable(std::string& name)
-{
-	switch (name[0])
+	Variable* var = nullptr;
+	switch (currentToken.getType())
 	{
-	case 'r':
-		for (Variables::iterator it = reg_vars.begin(); it != reg_vars.end(); ++it)
-			if ((*it)->getName() == name)
-				return *it;
+	case T_R_ID:
+		var = symbols.find(Variable::REG_VAR, currentToken.getNameId());
 		break;
-	case 'm':
-		for (Variables::iterator it = mem_vars.begin(); it != mem_vars.end(); ++it)
-			if ((*it)->getName() == name)
-				return *it;
+	case T_M_ID:
+		var = symbols.find(Variable::MEM_VAR, currentToken.getNameId());
+		break;
+	default:
 		break;
-	case 'c':
-		for (Variables::iterator it = const_vars.begin(); it != const_vars.end(); ++it)
-			if ((*it)->getName() == name)
-				return *it;
-		Variable* var = new Variable(Variable::CONST_VAR, "c" + name, stoi(name.replace(0, 1, "")));
-		const_vars.push_back(var);
-		return var;
 	}
+	if (var != nullptr)
+		return var;
+
 	err = true;
 	std::cerr << "Variable not found!" << std::endl;
 	throw VARIABLE_DOESNT_EXIST;
 }
 
-//  Metoda koja pronalazi labelu na osnovu imena.
-Variable* SyntaxAnalysis::findLabel(std::string& name)
+// Metoda koja vraća konstantnu promenljivu sa zadatom vrednošću (kreira je ako ne postoji).
+Variable* SyntaxAnalysis::constVariable(int value)
 {
-	for (Variables::iterator it = label_vars.begin(); it != label_vars.end(); ++it)
-		if ((*it)->getName() == name)
-			return *it;
-	Variable* var = new Variable(Variable::LABEL_VAR, name, 0);
+	Variable* var = symbols.find(Variable::CONST_VAR, value);
+	if (var != nullptr)
+		return var;
+	var = context.newVariable(Variable::CONST_VAR, "c" + std::to_string(value), value);
+	symbols.insert(Variable::CONST_VAR, value, var);
+	const_vars.push_back(var);
+	return var;
+}
+
+//  Metoda koja pronalazi labelu na osnovu imena trenutnog tokena (kreira je ako ne postoji).
+Variable* SyntaxAnalysis::findLabel()
+{
+	int nameId = currentToken.getNameId();
+	Variable* var = symbols.find(Variable::LABEL_VAR, nameId);
+	if (var != nullptr)
+		return var;
+	var = context.newVariable(Variable::LABEL_VAR, currentToken.getValue().str(), 0);
+	symbols.insert(Variable::LABEL_VAR, nameId, var);
 	label_vars.push_back(var);
 	return var;
 }
@@ -289,7 +321,7 @@ void SyntaxAnalysis::Q()
 // Funkcija S
 void SyntaxAnalysis::S()
 {
-	switch (currentToken->getType())
+	switch (currentToken.getType())
 	{
 	case T_MEM:
 		eat(T_MEM);
@@ -301,11 +333,10 @@ void SyntaxAnalysis::S()
 		break;
 	case T_FUNC:
 		eat(T_FUNC);
-		label_vars.push_back(createVariable());
-		instrs.push_back(new Instruction(I_NO_TYPE, label_vars.back()));
+		instrs.push_back(context.newInstruction(I_NO_TYPE, createVariable()));
 		break;
 	case T_ID:
-		label_vars.push_back(createVariable());
+		next_label = createVariable();
 		next_instruction_has_label = true;
 		eat(T_COL);
 		E();
@@ -318,7 +349,7 @@ void SyntaxAnalysis::S()
 // Funkcija S
 void SyntaxAnalysis::L()
 {
-	if (currentToken->getType() == T_END_OF_FILE) {
+	if (currentToken.getType() == T_END_OF_FILE) {
 		eat(T_END_OF_FILE); 
 	}
 	else {
@@ -333,11 +364,11 @@ void SyntaxAnalysis::E()
 	Variable* src1;
 	Variable* src2;
 	Variable* dst;
-	switch (currentToken->getType())
+	switch (currentToken.getType())
 	{
 	case T_ADD:
 		eat(T_ADD);
-		i = new Instruction(I_ADD);
+		i = context.newInstruction(I_ADD);
 
 		glance(T_R_ID);
 		dst = findVariable();
@@ -359,7 +390,7 @@ void SyntaxAnalysis::E()
 		break;
 	case T_ADDI:
 		eat(T_ADDI);
-		i = new Instruction(I_ADDI);
+		i = context.newInstruction(I_ADDI);
 
 		glance(T_R_ID);
 		dst = findVariable();
@@ -372,7 +403,7 @@ void SyntaxAnalysis::E()
 		eat(T_COMMA);
 
 		glance(T_NUM);
-		src2 = constVariable(stoi(currentToken->getValue()));
+		src2 = constVariable(currentToken.getValue().toInt());
 		eat(T_NUM);
 
 		i->addDst(dst);
@@ -381,7 +412,7 @@ void SyntaxAnalysis::E()
 		break;
 	case T_SUB:
 		eat(T_SUB);
-		i = new Instruction(I_SUB);
+		i = context.newInstruction(I_SUB);
 
 		glance(T_R_ID);
 		dst = findVariable();
@@ -403,7 +434,7 @@ void SyntaxAnalysis::E()
 		break;
 	case T_LA:
 		eat(T_LA);
-		i = new Instruction(I_LA);
+		i = context.newInstruction(I_LA);
 
 		glance(T_R_ID);
 		dst = findVariable();
@@ -419,7 +450,7 @@ void SyntaxAnalysis::E()
 		break;
 	case T_LW:
 		eat(T_LW);
-		i = new Instruction(I_LW);
+		i = context.newInstruction(I_LW);
 
 		glance(T_R_ID);
 		dst = findVariable();
@@ -427,7 +458,7 @@ void SyntaxAnalysis::E()
 		eat(T_COMMA);
 
 		glance(T_NUM);
-		src1 = constVariable(stoi(currentToken->getValue()));
+		src1 = constVariable(currentToken.getValue().toInt());
 		eat(T_NUM);
 		eat(T_L_PARENT);
 
@@ -442,7 +473,7 @@ void SyntaxAnalysis::E()
 		break;
 	case T_LI:
 		eat(T_LI);
-		i = new Instruction(I_LI);
+		i = context.newInstruction(I_LI);
 
 		glance(T_R_ID);
 		dst = findVariable();
@@ -450,7 +481,7 @@ void SyntaxAnalysis::E()
 		eat(T_COMMA);
 
 		glance(T_NUM);
-		src1 = constVariable(stoi(currentToken->getValue()));
+		src1 = constVariable(currentToken.getValue().toInt());
 		eat(T_NUM);
 
 		i->addDst(dst);
@@ -458,7 +489,7 @@ void SyntaxAnalysis::E()
 		break;
 	case T_SW:
 		eat(T_SW);
-		i = new Instruction(I_SW);
+		i = context.newInstruction(I_SW);
 
 		glance(T_R_ID);
 		src1 = findVariable();
@@ -466,7 +497,7 @@ void SyntaxAnalysis::E()
 		eat(T_COMMA);
 
 		glance(T_NUM);
-		src2 = constVariable(stoi(currentToken->getValue()));
+		src2 = constVariable(currentToken.getValue().toInt());
 		eat(T_NUM);
 		eat(T_L_PARENT);
 
@@ -481,17 +512,17 @@ void SyntaxAnalysis::E()
 		break;
 	case T_B:
 		eat(T_B);
-		i = new Instruction(I_B);
+		i = context.newInstruction(I_B);
 
 		glance(T_ID);
-		src1 = findLabel(currentToken->getValue());
+		src1 = findLabel();
 		eat(T_ID);
 
 		i->addSrc(src1);
 		break;
 	case T_BLTZ:
 		eat(T_BLTZ);
-		i = new Instruction(I_BLTZ);
+		i = context.newInstruction(I_BLTZ);
 
 		glance(T_R_ID);
 		src1 = findVariable();
@@ -499,7 +530,7 @@ void SyntaxAnalysis::E()
 		eat(T_COMMA);
 
 		glance(T_ID);
-		src2 = findLabel(currentToken->getValue());
+		src2 = findLabel();
 		eat(T_ID);
 
 		i->addSrc(src1);
@@ -507,11 +538,11 @@ void SyntaxAnalysis::E()
 		break;
 	case T_NOP:
 		eat(T_NOP);
-		i = new Instruction(I_NOP);
+		i = context.newInstruction(I_NOP);
 		break;
 	case T_BNE:
 		eat(T_BNE);
-		i = new Instruction(I_BNE);
+		i = context.newInstruction(I_BNE);
 
 		glance(T_R_ID);
 		src1 = findVariable();
@@ -524,7 +555,7 @@ void SyntaxAnalysis::E()
 		eat(T_COMMA);
 
 		glance(T_ID);
-		dst = findLabel(currentToken->getValue());
+		dst = findLabel();
 		eat(T_ID);
 
 		i->addSrc(src1);
@@ -537,7 +568,7 @@ void SyntaxAnalysis::E()
 		throw(WRONG_TOKEN);
 	}
 	if (next_instruction_has_label)
-		i->addLabel(label_vars.back());
+		i->addLabel(next_label);
 	instrs.push_back(i);
 }
 
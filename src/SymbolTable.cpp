@@ -0,0 +1,85 @@
+#include "SymbolTable.h"
+
+// Početni broj mesta u tabeli, mora biti stepen dvojke.
+static const unsigned int INITIAL_SLOTS = 64;
+
+// Konstruktor - pravi praznu tabelu.
+SymbolTable::SymbolTable() : m_entries(), m_size(0)
+{
+	clear();
+}
+
+// Pakuje vrstu promenljive i ključ u jedan 64-bitni ključ.
+unsigned long long SymbolTable::makeKey(Variable::VariableType type, int key)
+{
+	return ((unsigned long long)type << 32) | (unsigned int)key;
+}
+
+// Meša bitove ključa (splitmix64 finalizator).
+unsigned int SymbolTable::hash(unsigned long long key)
+{
+	key ^= key >> 33;
+	key *= 0xff51afd7ed558ccdULL;
+	key ^= key >> 33;
+	key *= 0xc4ceb9fe1a85ec53ULL;
+	key ^= key >> 33;
+	return (unsigned int)key;
+}
+
+// Pronalazi mesto sa datim ključem ili prazno mesto na koje ključ treba upisati.
+unsigned int SymbolTable::findSlot(unsigned long long key) const
+{
+	unsigned int mask = (unsigned int)m_entries.size() - 1;
+	unsigned int slot = hash(key) & mask;
+	while (m_entries[slot].var != nullptr && m_entries[slot].key != key)
+		slot = (slot + 1) & mask;
+	return slot;
+}
+
+// Vraća promenljivu date vrste sa datim ključem ili nullptr.
+Variable* SymbolTable::find(Variable::VariableType type, int key) const
+{
+	return m_entries[findSlot(makeKey(type, key))].var;
+}
+
+// Dodaje promenljivu u tabelu.
+void SymbolTable::insert(Variable::VariableType type, int key, Variable* var)
+{
+	unsigned long long packed = makeKey(type, key);
+	unsigned int slot = findSlot(packed);
+	if (m_entries[slot].var == nullptr)
+		++m_size;
+	m_entries[slot].key = packed;
+	m_entries[slot].var = var;
+
+	// faktor popunjenosti se drži ispod jedne polovine
+	if ((unsigned int)m_size * 2 > m_entries.size())
+		grow();
+}
+
+// Vraća broj simbola u tabeli.
+int SymbolTable::size() const
+{
+	return m_size;
+}
+
+// Prazni tabelu.
+void SymbolTable::clear()
+{
+	Entry empty = { 0, nullptr };
+	m_entries.assign(INITIAL_SLOTS, empty);
+	m_size = 0;
+}
+
+// Udvostručava broj mesta i ponovo upisuje sve simbole.
+void SymbolTable::grow()
+{
+	std::vector<Entry> old;
+	old.swap(m_entries);
+
+	Entry empty = { 0, nullptr };
+	m_entries.assign(old.size() * 2, empty);
+	for (Entry& e : old)
+		if (e.var != nullptr)
+			m_entries[findSlot(e.key)] = e;
+}
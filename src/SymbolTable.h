@@ -0,0 +1,73 @@
+#ifndef __SYMBOL_TABLE__
+#define __SYMBOL_TABLE__
+
+#include <vector>
+
+#include "IR.h"
+
+
+/**
+ * Symbol table of the parsed program.
+ * Variables are keyed by their kind and by the interned name id (see NameTable),
+ * constants are keyed by their value. It is an open addressing hash table with linear
+ * probing, so lookups and duplicate checks take constant time regardless of program size.
+ */
+class SymbolTable
+{
+public:
+	SymbolTable();
+
+	/**
+	 * Returns the variable of the given kind with the given key, or nullptr if there is none
+	 * [in] type - kind of the variable (MEM_VAR, REG_VAR, LABEL_VAR or CONST_VAR)
+	 * [in] key  - interned name id, or the value for constants
+	 */
+	Variable* find(Variable::VariableType type, int key) const;
+
+	/**
+	 * Adds the variable under the given kind and key, an existing entry is replaced
+	 */
+	void insert(Variable::VariableType type, int key, Variable* var);
+
+	/**
+	 * Returns number of symbols in the table
+	 */
+	int size() const;
+
+	/**
+	 * Removes all symbols (the variables themselves are not deleted)
+	 */
+	void clear();
+
+private:
+	struct Entry
+	{
+		unsigned long long key;
+		Variable* var;
+	};
+
+	/**
+	 * Packs kind and key into one 64 bit key
+	 */
+	static unsigned long long makeKey(Variable::VariableType type, int key);
+
+	/**
+	 * Spreads the bits of the key over the whole word
+	 */
+	static unsigned int hash(unsigned long long key);
+
+	/**
+	 * Returns the slot holding the key or the empty slot where it should be inserted
+	 */
+	unsigned int findSlot(unsigned long long key) const;
+
+	/**
+	 * Doubles the number of slots and reinserts all entries
+	 */
+	void grow();
+
+	std::vector<Entry> m_entries;   // Slots, an empty slot has var == nullptr
+	int m_size;                     // Number of used slots
+};
+
+#endif
@@ -9,6 +9,7 @@
 
 #include "LexicalAnalysis.h"
 #include "IR.h"
+#include "CompilationContext.h"
 
 /**
 * Class that analyses tokens gotten from lexical analysis
@@ -33,14 +34,12 @@ public:
 	/**
 	* Constructor which prepares the object to do syntax analysis
 	* [in] lexer - results gotten form the lexical analysis
+	* [in] context - compilation which receives the parsed instructions and variables
+	* [in] streamTokens - if true tokens are pulled from the lexer one by one while parsing
+	*		and the token list is never built (lexer.Do() must not be called beforehand),
+	*		otherwise the token list filled by lexer.Do() is walked
 	*/
-	SyntaxAnalysis(LexicalAnalysis& lexer);
-
-	/**
-	* Destructor that ensures that all pointers are deleted when syntax
-	* analysis object goes out of scope
-	*/
-	~SyntaxAnalysis();
+	SyntaxAnalysis(LexicalAnalysis& lexer, CompilationContext& context, bool streamTokens = false);
 
 	/**
 	* Method which does syntax analysis
@@ -51,11 +50,11 @@ public:
 	/**
 	* instructions gotten from syntax analysis
 	*/
-	void printInstructions();
+	void printInstructions(std::ostream& out = std::cout);
 	/**
 	* Print variables gotten from syntax analysis
 	*/
-	void printVariables();
+	void printVariables(std::ostream& out = std::cout);
 
 	/**
 	* Returns a reference to the list of register variables
@@ -73,71 +72,89 @@ public:
 	*/
 	Instructions& getInstructions();
 
+	/**
+	* Method that returns a pointer to a constant variable
+	* (creates a constant/immediate if it doesn't already exist, this is done so that all
+	* constants in the program are saved as variables, but also so that if the same number is
+	* used multiple times there is only one copy of it)
+	* [in]  value - intiger number that represent the passed in value
+	* [out] return - pointer to the wanted variable
+	*/
+	Variable* constVariable(int value);
+	/**
+	* Method that creates a new label for code generated by optimizations. The name is the
+	* prefix followed by a number, a prefix starting with '_' can't clash with program labels
+	* [in]  prefix - beginning of the label name
+	* [out] return - pointer to the created label
+	*/
+	Variable* newLabel(const std::string& prefix);
+
+	/**
+	* Returns the compilation which owns all variables and instructions of the program, passes
+	* create new IR objects through it and never delete them
+	*/
+	CompilationContext& getContext();
+
 private:
 	/**
-	* Private method which moves the iterator to the next token
+	* Private method which moves to the next token
 	(eats the upcoming one) and return if there has been an error
-	* [in] token - expected token type to which to compare the current token the iterator is pointing at
+	* [in] token - expected token type to which to compare the current token
 	*/
 	void eat(TokenType token);
 
 	/**
-	* Private method which checks if the iterator to the next token
-	points to the correct type of token to be able to read it
-	* [in] token - expected token type to which to compare the current token the iterator is pointing at
+	* Private method which checks if the current token
+	is the correct type of token to be able to read it
+	* [in] token - expected token type to which to compare the current token
 	*/
 	void glance(TokenType token);
 
+	/**
+	* Private method which loads the next token into currentToken, either from
+	* the token list (by index) or directly from the lexer in streaming mode
+	*/
+	void advance();
+
+	/**
+	* Private method which pulls the next token from the lexer in streaming mode. A lexical error
+	* is reported through the lexer (as without streaming) and throws runtime_error
+	*/
+	void pullToken();
+
 	/**
 	* Check if register variable with the given name already exists and raise error if it does
-	* [in] name - string to which to compare register variable names to
+	* [in] nameId - interned id of the name to look for
 	*/
-	void regVariableExists(std::string& name);
+	void regVariableExists(int nameId);
 	/**
 	* Check if memory variable with the given name already exists and raise error if it does
-	* [in] name - string to which to compare memory variable names to
+	* [in] nameId - interned id of the name to look for
 	*/
-	void memVariableExists(std::string& name);
+	void memVariableExists(int nameId);
 	/**
-	* Check if label with the given name already exists and raise error if it does
-	* [in] name - string to which to compare names of existing labels
+	* Check if label with the given name is already defined and raise error if it is
+	* [in] nameId - interned id of the name to look for
 	*/
-	void labelExists(std::string& name);
+	void labelExists(int nameId);
 
 	/**
 	* Method which looks at the next token and turns it into a correct type of variable
+	* and adds it to the symbol table (a label referenced earlier by a branch is only marked as defined)
 	* [out] return - pointer to the created variable
 	*/
 	Variable* createVariable();
 	/**
-	* Method that returns a pointer to the variable with the same name as the current token looked at
+	* Method that returns a pointer to the register or memory variable named by the current token
 	* [out] return - pointer to the found variable
 	*/
 	Variable* findVariable();
 	/**
-	* Method that returns a pointer to a constant variable
-	* [in]  value - intiger number that represent the passed in value
-	* [out] return - pointer to the wanted variable
-	*/
-	Variable* constVariable(int value);
-	/**
-	* Method that returns a pointer to the variable with the same name as the string given to it
-	*
-	* To create a constant variable pass in ("c" + value) as the argument
-	* (creates a constant/immediate if it doesn't already exist, this is done so that all
-	* constants in the program are saved as variables, but also so that if the same number is
-	* used multiple times there is only one copy of it)
-	*
-	* [in]  name - string of the variable you are trying to find
-	* [out] return - pointer to the found variable
-	*/
-	Variable* findVariable(std::string& name);
-	/**
-	* Method that returns a pointer to the variable with the same name as the string given to it
-	* [in]  name - string of the variable you are trying to find
-	* [out] return - pointer to the found variable
+	* Method that returns a pointer to the label named by the current token
+	* (creates it if it is referenced before being defined)
+	* [out] return - pointer to the found label
 	*/
-	Variable* findLabel(std::string& name);
+	Variable* findLabel();
 	/**
 	* Method that is used to raise an error at the end if a jump/branching was called
 	* to a label that doesn't exist (is connected to nothing)
@@ -159,12 +176,17 @@ private:
 	void E();                   // Funkcija E
 
 	LexicalAnalysis& lex;       // Referenca na rezultate leksičke analize
-	TokenList::iterator currentToken; // Trenutni token koji se analizira
-	Instructions instrs;        // Lista instrukcija
-	Variables reg_vars;         // Lista registarskih promenljivih
-	Variables mem_vars;         // Lista promenljivih za memorijske adrese
-	Variables label_vars;       // Lista oznaka
-	Variables const_vars;       // Lista promenljivih koje drže konstantne vrednosti
+	bool streamTokens;          // Da li se tokeni uzimaju direktno od leksera umesto iz liste
+	unsigned int tokenIndex;    // Indeks trenutnog tokena u listi tokena
+	Token currentToken;         // Trenutni token koji se analizira
+	CompilationContext& context; // Vlasnik svih promenljivih i instrukcija
+	Instructions& instrs;       // Lista instrukcija
+	Variables& reg_vars;        // Lista registarskih promenljivih
+	Variables& mem_vars;        // Lista promenljivih za memorijske adrese
+	Variables& label_vars;      // Lista oznaka
+	Variables& const_vars;      // Lista promenljivih koje drže konstantne vrednosti
+	SymbolTable& symbols;       // Heš tabela svih promenljivih, labela i konstanti
+	Variable* next_label;       // Labela koju treba dodeliti sledećoj instrukciji
 	bool err;                   // Booleova vrednost koja pokazuje da li je došlo do greške
 	bool eof;                   // Booleova vrednost koja predstavlja da li je pročitan EOF token
 	bool next_instruction_has_label;  // Booleova vrednost koja, ako je tačna, govori da sledeća instrukcija treba da ima oznaku
@@ -0,0 +1,122 @@
+#include "Target.h"
+
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+
+// Registers which have a fixed role in the MIPS calling convention and are never allocated
+static const char* const reservedRegisters[] =
+{
+	"$zero", "$0", "$at", "$1", "$k0", "$26", "$k1", "$27",
+	"$gp", "$28", "$sp", "$29", "$fp", "$30", "$ra", "$31"
+};
+
+
+Target::Target()
+{
+	m_registers.push_back("$t0");
+	m_registers.push_back("$t1");
+	m_registers.push_back("$t2");
+	m_registers.push_back("$t3");
+}
+
+
+void Target::load(const string& fileName)
+{
+	ifstream file(fileName);
+	if (!file.is_open())
+		throw runtime_error("\nException! Failed to open target description " + fileName + "!\n");
+	parse(file, fileName);
+}
+
+
+void Target::setRegisters(const string& list)
+{
+	istringstream in(list);
+	parse(in, "--regs");
+}
+
+
+int Target::getRegisterCount() const
+{
+	return (int)m_registers.size();
+}
+
+
+const string& Target::getRegisterName(Regs reg) const
+{
+	return m_registers.at(reg - 1);
+}
+
+
+int Target::getRegisterNumber(const string& name)
+{
+	static const char* const names[32] =
+	{
+		"$zero", "$at", "$v0", "$v1", "$a0", "$a1", "$a2", "$a3",
+		"$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
+		"$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+		"$t8", "$t9", "$k0", "$k1", "$gp", "$sp", "$fp", "$ra"
+	};
+
+	for (int i = 0; i < 32; i++)
+		if (name == names[i])
+			return i;
+
+	if (name.size() < 2 || name.size() > 3 || name[0] != '$')
+		return -1;
+	int number = 0;
+	for (size_t i = 1; i < name.size(); i++)
+	{
+		if (!isdigit((unsigned char)name[i]))
+			return -1;
+		number = number * 10 + (name[i] - '0');
+	}
+	return number < 32 ? number : -1;
+}
+
+
+void Target::parse(istream& in, const string& where)
+{
+	vector<string> registers;
+	string line;
+	while (getline(in, line))
+	{
+		size_t comment = line.find('#');
+		if (comment != string::npos)
+			line.erase(comment);
+		replace(line.begin(), line.end(), ',', ' ');
+
+		istringstream words(line);
+		string name;
+		while (words >> name)
+		{
+			if (name[0] != '$')
+				name = "$" + name;
+
+			bool valid = name.size() > 1;
+			for (size_t i = 1; i < name.size(); i++)
+				valid = valid && isalnum((unsigned char)name[i]);
+			if (!valid)
+				throw runtime_error("\nException! Invalid register name " + name + " in " + where + "!\n");
+
+			for (const char* reserved : reservedRegisters)
+				if (name == reserved)
+					throw runtime_error("\nException! Register " + name + " in " + where + " is reserved and can't be allocated!\n");
+
+			if (find(registers.begin(), registers.end(), name) != registers.end())
+				throw runtime_error("\nException! Register " + name + " is listed twice in " + where + "!\n");
+
+			registers.push_back(name);
+		}
+	}
+
+	if (registers.empty())
+		throw runtime_error("\nException! No registers given in " + where + "!\n");
+	m_registers.swap(registers);
+}
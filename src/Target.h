@@ -0,0 +1,64 @@
+#ifndef __TARGET__
+#define __TARGET__
+
+#include "Types.h"
+
+#include <istream>
+#include <string>
+#include <vector>
+
+
+/**
+ * Description of the target processor: the registers the allocator may hand out.
+ * Register colors are indexes into the list counted from 1 (0 is no_assign).
+ */
+class Target
+{
+public:
+	/**
+	 * Default target with $t0-$t3
+	 */
+	Target();
+
+	/**
+	 * Reads the register list from a target description file: register names separated
+	 * by whitespace or commas, '#' starts a comment which runs to the end of the line
+	 * [in] fileName - path of the target description
+	 * throws runtime_error if the file can't be read or a register name is invalid
+	 */
+	void load(const std::string& fileName);
+
+	/**
+	 * Sets the register list from a comma separated string (e.g. "$t0,$t1,$s0"),
+	 * the leading '$' may be left out
+	 * throws runtime_error if a register name is invalid
+	 */
+	void setRegisters(const std::string& list);
+
+	/**
+	 * Returns the number of allocatable registers
+	 */
+	int getRegisterCount() const;
+
+	/**
+	 * Returns the assembly name of the register with the given color (1..getRegisterCount())
+	 */
+	const std::string& getRegisterName(Regs reg) const;
+
+	/**
+	 * Returns the hardware number (0..31) of a register given by its assembly name
+	 * ("$t0" or "$8"), -1 if there is no such register
+	 */
+	static int getRegisterNumber(const std::string& name);
+
+private:
+	/**
+	 * Reads register names from the stream and replaces the current list with them
+	 * [in] where - name of the source used in error messages
+	 */
+	void parse(std::istream& in, const std::string& where);
+
+	std::vector<std::string> m_registers;
+};
+
+#endif
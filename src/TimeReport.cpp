@@ -0,0 +1,238 @@
+#include "TimeReport.h"
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+// Vraća vreme u mikrosekundama
+static double wallTime()
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Vraća procesorsko vreme procesa u mikrosekundama
+static double cpuTime()
+{
+	return 1e6 * std::clock() / CLOCKS_PER_SEC;
+}
+
+// Vraća najveću zauzetu fizičku memoriju procesa u KB
+static long long peakRss()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return (long long)(counters.PeakWorkingSetSize / 1024);
+	return 0;
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+		return usage.ru_maxrss;
+	return 0;
+#endif
+}
+
+// Ispisuje string kao JSON string
+static void writeString(std::ostream& out, const std::string& text)
+{
+	out << '"';
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+			out << '\\';
+		out << c;
+	}
+	out << '"';
+}
+
+TimeReport::Scope::Scope(TimeReport& report, const char* name) : report(report), active(report.isEnabled())
+{
+	if (active)
+		report.begin(name);
+}
+
+TimeReport::Scope::~Scope()
+{
+	if (active)
+		report.end();
+}
+
+TimeReport::TimeReport() : enabled(false), countAllocations(nullptr), countBytes(nullptr), origin(0)
+{
+}
+
+// Uključuje merenje
+void TimeReport::enable()
+{
+	enabled = true;
+	origin = wallTime();
+}
+
+bool TimeReport::isEnabled() const
+{
+	return enabled;
+}
+
+// Postavlja funkcije koje vraćaju brojače alokacija
+void TimeReport::setAllocationCounters(AllocationCounter count, AllocationCounter bytes)
+{
+	countAllocations = count;
+	countBytes = bytes;
+}
+
+// Vraća broj alokacija (nula ako brojač nije postavljen)
+unsigned long long TimeReport::allocations() const
+{
+	return countAllocations != nullptr ? countAllocations() : 0;
+}
+
+// Vraća ukupnu veličinu alokacija (nula ako brojač nije postavljen)
+unsigned long long TimeReport::allocatedBytes() const
+{
+	return countBytes != nullptr ? countBytes() : 0;
+}
+
+// Započinje merenje faze
+void TimeReport::begin(const char* name)
+{
+	Phase phase;
+	phase.name = name;
+	phase.path = open.empty() ? phase.name : phases[open.back()].path + "/" + phase.name;
+	phase.depth = (int)open.size();
+	phase.wall = phase.cpu = 0;
+	phase.peakRss = 0;
+	phase.allocations = phase.bytes = 0;
+
+	open.push_back((int)phases.size());
+	phases.push_back(phase);
+
+	// merenje počinje nakon sopstvenih alokacija
+	Phase& p = phases.back();
+	p.startRss = peakRss();
+	p.startAllocations = allocations();
+	p.startBytes = allocatedBytes();
+	p.startCpu = cpuTime();
+	p.start = wallTime() - origin;
+}
+
+// Završava merenje poslednje započete faze
+void TimeReport::end()
+{
+	double now = wallTime() - origin;
+	double cpu = cpuTime();
+	Phase& p = phases[open.back()];
+	open.pop_back();
+
+	p.wall = now - p.start;
+	p.cpu = cpu - p.startCpu;
+	p.peakRss = peakRss() - p.startRss;
+	p.allocations = allocations() - p.startAllocations;
+	p.bytes = allocatedBytes() - p.startBytes;
+}
+
+// Ispisuje tabelu faza, ponovljene faze su sabrane u jedan red
+void TimeReport::printTable(std::ostream& out) const
+{
+	std::vector<Phase> rows;
+	std::vector<int> calls;
+	for (const Phase& p : phases)
+	{
+		unsigned int r = 0;
+		while (r < rows.size() && rows[r].path != p.path)
+			++r;
+		if (r == rows.size())
+		{
+			rows.push_back(p);
+			calls.push_back(1);
+			continue;
+		}
+		rows[r].wall += p.wall;
+		rows[r].cpu += p.cpu;
+		rows[r].peakRss += p.peakRss;
+		rows[r].allocations += p.allocations;
+		rows[r].bytes += p.bytes;
+		++calls[r];
+	}
+
+	std::ios::fmtflags flags = out.flags();
+	out << ">>>>>=====-----\n"
+		<< "| Time report:\n"
+		<< ">>>>>=====-----\n"
+		<< std::left << std::setw(36) << "| phase" << std::right
+		<< std::setw(7) << "calls" << std::setw(12) << "wall ms" << std::setw(12) << "cpu ms"
+		<< std::setw(14) << "peak RSS KB" << std::setw(12) << "allocs" << std::setw(14) << "alloc KB" << "\n";
+	out << std::fixed << std::setprecision(3);
+	for (unsigned int r = 0; r < rows.size(); ++r)
+	{
+		const Phase& p = rows[r];
+		out << std::left << std::setw(36) << ("| " + std::string(2 * p.depth, ' ') + p.name) << std::right
+			<< std::setw(7) << calls[r]
+			<< std::setw(12) << p.wall / 1000 << std::setw(12) << p.cpu / 1000
+			<< std::setw(14) << p.peakRss << std::setw(12) << p.allocations
+			<< std::setw(14) << p.bytes / 1024.0 << "\n";
+	}
+	out.flags(flags);
+}
+
+// Upisuje sve izvršene faze u JSON fajl
+void TimeReport::writeJson(const std::string& fileName) const
+{
+	std::ofstream out(fileName);
+	if (!out)
+		throw std::runtime_error("\nException! Failed to open time report file " + fileName + "!\n");
+
+	out << "[\n";
+	for (unsigned int k = 0; k < phases.size(); ++k)
+	{
+		const Phase& p = phases[k];
+		out << "  {\"name\": ";
+		writeString(out, p.name);
+		out << ", \"path\": ";
+		writeString(out, p.path);
+		out << ", \"depth\": " << p.depth
+			<< ", \"start_us\": " << (long long)p.start
+			<< ", \"wall_us\": " << (long long)p.wall
+			<< ", \"cpu_us\": " << (long long)p.cpu
+			<< ", \"peak_rss_delta_kb\": " << p.peakRss
+			<< ", \"allocations\": " << p.allocations
+			<< ", \"allocated_bytes\": " << p.bytes << "}"
+			<< (k + 1 < phases.size() ? ",\n" : "\n");
+	}
+	out << "]\n";
+}
+
+// Upisuje faze kao Chrome trace događaje (kompletni događaji "X")
+void TimeReport::writeTrace(const std::string& fileName) const
+{
+	std::ofstream out(fileName);
+	if (!out)
+		throw std::runtime_error("\nException! Failed to open time report file " + fileName + "!\n");
+
+	out << "{\"traceEvents\": [\n";
+	for (unsigned int k = 0; k < phases.size(); ++k)
+	{
+		const Phase& p = phases[k];
+		out << "  {\"name\": ";
+		writeString(out, p.name);
+		out << ", \"cat\": \"compiler\", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+			<< ", \"ts\": " << (long long)p.start
+			<< ", \"dur\": " << (long long)p.wall
+			<< ", \"args\": {\"cpu_us\": " << (long long)p.cpu
+			<< ", \"peak_rss_delta_kb\": " << p.peakRss
+			<< ", \"allocations\": " << p.allocations
+			<< ", \"allocated_bytes\": " << p.bytes << "}}"
+			<< (k + 1 < phases.size() ? ",\n" : "\n");
+	}
+	out << "], \"displayTimeUnit\": \"ms\"}\n";
+}
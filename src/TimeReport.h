@@ -0,0 +1,103 @@
+#ifndef __TIME_REPORT__
+#define __TIME_REPORT__
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/**
+ * Per-phase instrumentation of the compiler: wall time, CPU time, growth of the peak resident
+ * set size and the number and size of heap allocations of every phase.
+ *
+ * Phases are measured with TimeReport::Scope objects and nest, so the liveness analysis can
+ * report its sub-phases. A phase which runs several times (one per iteration of the analysis)
+ * is shown once in the table with the number of calls, JSON and trace output keep every run.
+ * Nothing is recorded until enable() is called.
+ */
+class TimeReport
+{
+public:
+	/**
+	 * Measures the phase from construction to destruction
+	 */
+	class Scope
+	{
+	public:
+		Scope(TimeReport& report, const char* name);
+		~Scope();
+
+	private:
+		TimeReport& report;
+		bool active;
+	};
+
+	TimeReport();
+
+	/**
+	 * Starts recording, the start time is the origin of the trace
+	 */
+	void enable();
+
+	bool isEnabled() const;
+
+	/**
+	 * Prints the phases as an indented table
+	 */
+	void printTable(std::ostream& out) const;
+
+	/**
+	 * Writes every recorded run of a phase as a JSON array
+	 */
+	void writeJson(const std::string& fileName) const;
+
+	/**
+	 * Writes the phases in the Chrome trace event format (chrome://tracing, Perfetto)
+	 */
+	void writeTrace(const std::string& fileName) const;
+
+	/**
+	 * Function which returns a heap allocation counter of the process
+	 */
+	typedef unsigned long long (*AllocationCounter)();
+
+	/**
+	 * Sets the functions which return the number and the total size of heap allocations. The
+	 * library doesn't count allocations itself, without counters the allocation columns are zero
+	 */
+	void setAllocationCounters(AllocationCounter count, AllocationCounter bytes);
+
+private:
+	struct Phase
+	{
+		std::string name;
+		std::string path;               // Names of the enclosing phases and the phase, separated by '/'
+		int depth;
+		double start;                   // Microseconds from enable()
+		double wall;                    // Microseconds
+		double cpu;                     // Microseconds
+		long long peakRss;              // Growth of the peak resident set size in KB
+		unsigned long long allocations;
+		unsigned long long bytes;
+
+		long long startRss;
+		double startCpu;
+		unsigned long long startAllocations;
+		unsigned long long startBytes;
+	};
+
+	void begin(const char* name);
+	void end();
+
+	unsigned long long allocations() const;
+	unsigned long long allocatedBytes() const;
+
+	bool enabled;
+	AllocationCounter countAllocations;
+	AllocationCounter countBytes;
+	double origin;
+	std::vector<Phase> phases;          // In the order the phases started
+	std::vector<int> open;              // Indexes of the phases which haven't ended
+};
+
+#endif
@@ -2,12 +2,45 @@
 
 #include <iostream>
 #include <iomanip>
+#include <cstring>
+#include <climits>
+#include <stdexcept>
 
 #include "Token.h"
 #include "FiniteStateMachine.h"
 
 using namespace std;
 
+// Konverzija leksema sastavljenog od cifara u broj.
+int Lexeme::toInt() const
+{
+	long long number = 0;
+	for (int i = 0; i < m_length; i++)
+	{
+		number = number * 10 + (m_begin[i] - '0');
+		if (number > INT_MAX)
+			throw runtime_error("\nException! Number " + str() + " is out of range!\n");
+	}
+	return (int)number;
+}
+
+// Poređenje leksema sa stringom bez pravljenja kopije.
+bool Lexeme::operator==(const string& s) const
+{
+	return (int)s.size() == m_length && memcmp(s.data(), m_begin, m_length) == 0;
+}
+
+bool operator==(const string& s, const Lexeme& l)
+{
+	return l == s;
+}
+
+// Ispis leksema u tok izlaza.
+ostream& operator<<(ostream& out, const Lexeme& l)
+{
+	return out.write(l.data(), l.length());
+}
+
 // Metoda koja vraća tip tokena.
 TokenType Token::getType()
 {
@@ -21,54 +54,64 @@ void Token::setType(TokenType t)
 }
 
 // Metoda koja vraća vrednost tokena.
-string Token::getValue()
+const Lexeme& Token::getValue() const
 {
 	return value;
 }
 
 // Metoda koja postavlja vrednost tokena.
-void Token::setValue(string s)
+void Token::setValue(const Lexeme& l)
 {
-	value = s;
+	value = l;
 }
 
-//  Metoda koja konstruiše token na osnovu ulaznih parametara.
-void Token::makeToken(int begin, int end, std::vector<char>& programBuffer, int lastFiniteState)
+// Metoda koja vraća id internovanog imena tokena.
+int Token::getNameId() const
 {
-	string _value = "";
-	for (int i = begin; i < end; i++)
-	{
-		_value += programBuffer[i];
-	}
-	value = _value;
+	return nameId;
+}
+
+// Metoda koja postavlja id internovanog imena tokena.
+void Token::setNameId(int id)
+{
+	nameId = id;
+}
+
+//  Metoda koja konstruiše token na osnovu ulaznih parametara (bez kopiranja karaktera).
+void Token::makeToken(int begin, int end, const char* programBuffer, int lastFiniteState)
+{
+	value = Lexeme(programBuffer + begin, end - begin);
 	tokenType = FiniteStateMachine::getTokenType(lastFiniteState);
+	nameId = -1;
 }
 
 // Metoda koja konstruiše token za grešku.
-void Token::makeErrorToken(int pos, std::vector<char>& programBuffer)
+void Token::makeErrorToken(int pos, const char* programBuffer)
 {
 	tokenType = T_ERROR;
-	value = programBuffer[pos];
+	value = Lexeme(programBuffer + pos, 1);
+	nameId = -1;
 }
 
 // Metoda koja konstruiše token za kraj datoteke.
 void Token::makeEofToken()
 {
 	tokenType = T_END_OF_FILE;
-	value = "EOF";
+	value = Lexeme("EOF", 3);
+	nameId = -1;
 }
 
 //  Metoda koja ispisuje informacije o tokenu.
-void Token::printTokenInfo()
+void Token::printTokenInfo(ostream& out)
 {
-	cout << setw(LEFT_ALIGN) << left << tokenTypeToString(tokenType);
-	cout << setw(RIGHT_ALIGN) << right << value << endl;
+	out << setw(LEFT_ALIGN) << left << tokenTypeToString(tokenType);
+	out << setw(RIGHT_ALIGN) << right << value.str() << endl;
 }
 
 // Metoda koja ispisuje vrednost tokena.
-void Token::printTokenValue()
+void Token::printTokenValue(ostream& out)
 {
-	cout << value << endl;
+	out << value << endl;
 }
 
 // Konverzija TokenType u string.
@@ -3,15 +3,66 @@
 
 #include <vector>
 #include <string>
+#include <iostream>
 
 #include "Constants.h"
 #include "Types.h"
 
 
+/**
+* Non-owning view of the characters of one token inside the program buffer.
+* It stays valid only as long as the buffer (or file mapping) it points into.
+*/
+class Lexeme
+{
+public:
+	Lexeme() : m_begin(""), m_length(0) {}
+	Lexeme(const char* begin, int length) : m_begin(begin), m_length(length) {}
+
+	/**
+	* Returns pointer to the first character of the lexeme
+	*/
+	const char* data() const { return m_begin; }
+
+	/**
+	* Returns number of characters in the lexeme
+	*/
+	int length() const { return m_length; }
+
+	/**
+	* Returns the character at the given position
+	*/
+	char operator[](int i) const { return m_begin[i]; }
+
+	/**
+	* Returns a copy of the lexeme as string
+	*/
+	std::string str() const { return std::string(m_begin, m_length); }
+
+	/**
+	* Converts a lexeme made of decimal digits to number
+	*/
+	int toInt() const;
+
+	/**
+	* Compares the lexeme with a string character by character
+	*/
+	bool operator==(const std::string& s) const;
+	bool operator!=(const std::string& s) const { return !(*this == s); }
+
+private:
+	const char* m_begin;
+	int m_length;
+};
+
+bool operator==(const std::string& s, const Lexeme& l);
+std::ostream& operator<<(std::ostream& out, const Lexeme& l);
+
+
 class Token
 {
 public:
-	Token() : tokenType(T_NO_TYPE), value("") {}
+	Token() : tokenType(T_NO_TYPE), value(), nameId(-1) {}
 
 	/**
 	* Returns token type
@@ -24,29 +75,39 @@ public:
 	void setType(TokenType t);
 
 	/**
-	* Returns token value
+	* Returns token value - a view into the program buffer, no copy is made
 	*/
-	std::string getValue();
+	const Lexeme& getValue() const;
 
 	/**
 	* Sets token value
 	*/
-	void setValue(std::string s);
+	void setValue(const Lexeme& l);
+
+	/**
+	* Returns id of the interned identifier name (see NameTable), -1 for tokens which are not identifiers
+	*/
+	int getNameId() const;
+
+	/**
+	* Sets id of the interned identifier name
+	*/
+	void setNameId(int id);
 
 	/**
 	* Creates a token
 	* [in] begin - start position in the program buffer - first character of the token
 	* [in] end - end position in the program buffer - end character of the token
-	* [in] program - program buffer
+	* [in] program - program buffer, it must outlive the token
 	* [in] lastFiniteState - number of the last finite state,
 	*		this is used to get the name of the state and store it as token type
 	*/
-	void makeToken(int begin, int end, std::vector<char>& program, int lastFiniteState);
+	void makeToken(int begin, int end, const char* program, int lastFiniteState);
 
 	/**
 	* Creates an error token, storing the errnous content as token value
 	*/
-	void makeErrorToken(int pos, std::vector<char>& program);
+	void makeErrorToken(int pos, const char* program);
 
 	/**
 	* Creates end of file token when it is reached
@@ -56,12 +117,12 @@ public:
 	/**
 	* Prints token type and value
 	*/
-	void printTokenInfo();
+	void printTokenInfo(std::ostream& out = std::cout);
 
 	/**
 	* Prints token value
 	*/
-	void printTokenValue();
+	void printTokenValue(std::ostream& out = std::cout);
 
 private:
 	/**
@@ -70,9 +131,14 @@ private:
 	TokenType tokenType;
 
 	/**
-	* Value of the token - as string
+	* Value of the token - as view into the program buffer
+	*/
+	Lexeme value;
+
+	/**
+	* Id of the interned name for T_ID, T_M_ID and T_R_ID tokens, otherwise -1
 	*/
-	std::string value;
+	int nameId;
 
 	/**
 	* Helper function to get string representation of token type
@@ -83,16 +83,32 @@ enum InstructionType
 
 };
 
+
+/**
+ * Register allocation algorithm.
+ */
+enum RegAllocType
+{
+	RA_GRAPH_COLORING,  // Chaitin-Briggs bojenje grafa interferencije
+	RA_LINEAR_SCAN      // Linearno skeniranje intervala života
+};
+
 /**
- * Reg names.
+ * When instructions are scheduled.
  */
-enum Regs
+enum ScheduleMode
 {
-	no_assign = 0,
-	t0,
-	t1,
-	t2,
-	t3
+	SCHED_NONE,         // Redosled iz izvornog koda, bez popunjavanja delay slotova
+	SCHED_PRE,          // Pre alokacije (nad promenljivama), više preklapanja ali veći pritisak na registre
+	SCHED_POST          // Nakon alokacije (nad registrima), ne menja dodelu registara
 };
 
+/**
+ * Register assigned to a register variable: index into the register list of the Target,
+ * counted from 1 (see Target.h).
+ */
+typedef int Regs;
+
+const Regs no_assign = 0;
+
 #endif
@@ -4,6 +4,13 @@
 #include <exception>
 
 #include "LivenessAnalysis.h"
+#include "Peephole.h"
+#include "Scheduler.h"
+#include "Simulator.h"
+#include "Options.h"
+#include "CompilationContext.h"
+#include "CountingAllocator.h"
+#include "ElfWriter.h"
 
 using namespace std;
 
@@ -12,67 +19,174 @@ Glavna funkcija programa koja pokreće analizu leksičkih, sintaksnih i živih a
 kao i alokaciju resursa. U slučaju bilo kakve greške, hvataju se izuzeci i ispisuje
 se odgovarajuća poruka o grešci.
 */
-int main()
+int main(int argc, char* argv[])
 {
+	CompilerOptions options;
+	if (!parseOptions(argc, argv, options))
+	{
+		printUsage(argv[0]);
+		return 1;
+	}
+
+	// Stanje prevođenja (IR, tabela simbola, ispisi i merenje faza)
+	CompilationContext context;
+
+	TimeReport& report = context.getTimeReport();
+	report.setAllocationCounters(allocationCount, allocatedBytes);
+	if (options.timeReport || !options.timeJson.empty() || !options.timeTrace.empty())
+		report.enable();
+
+	Dump& dump = context.getDump();
+	dump.enable(options.dumps);
+
 	try
 	{
-		vector<string> fileNames =
-		{
-			".\\..\\examples\\simple.mavn",
-			".\\..\\examples\\multiply.mavn",
-			".\\..\\examples\\xor.mavn"
-		};
-		string outputFile = ".\\..\\examples\\out.s";
+		if (!options.dumpFile.empty())
+			dump.setFile(options.dumpFile);
+
+		string outputFile = options.outputFile;
 		bool retVal = false;
 
+		// Opis ciljne arhitekture (registri koje alokator sme da koristi)
+		Target target;
+		if (!options.targetFile.empty())
+			target.load(options.targetFile);
+		if (!options.registers.empty())
+			target.setRegisters(options.registers);
+
 		LexicalAnalysis lex;
 
 		// Učitavanje ulaznih fajlova
-		if (!lex.readInputFile(fileNames[0]))
-			throw runtime_error("\nException! Failed to open input file!\n");
-
-		lex.initialize();
+		{
+			TimeReport::Scope scope(report, "read input");
+			if (!lex.readInputFile(options.inputFile))
+				throw runtime_error("\nException! Failed to open input file!\n");
 
-		// Pokretanje analize leksičkog programa
-		retVal = lex.Do();
+			lex.initialize();
+		}
 
-		if (retVal)
+		// Pokretanje analize leksičkog programa (u režimu strujanja tokene traži parser)
+		if (!options.streamTokens)
 		{
-			cout << "Lexical analysis finished successfully!" << endl;
-			lex.printTokens();
+			{
+				TimeReport::Scope scope(report, "lexical analysis");
+				retVal = lex.Do();
+			}
+
+			if (retVal)
+			{
+				cout << "Lexical analysis finished successfully!" << endl;
+				if (dump.enabled(DUMP_TOKENS))
+					lex.printTokens(dump.stream());
+			}
+			else
+			{
+				lex.printLexError();
+				throw runtime_error("\nException! Lexical analysis failed!\n");
+			}
 		}
-		else
+
+		SyntaxAnalysis syn(lex, context, options.streamTokens);
 		{
-			lex.printLexError();
-			throw runtime_error("\nException! Lexical analysis failed!\n");
+			TimeReport::Scope scope(report, "syntax analysis");
+			retVal = syn.Do();
 		}
-
-		SyntaxAnalysis syn(lex);
-		retVal = syn.Do();
 		if (retVal)
 		{
 			cout << "\nSyntax analysis finished successfully!" << endl;
-			syn.printInstructions();
-			syn.printVariables();
+			if (dump.enabled(DUMP_INSTRUCTIONS))
+				syn.printInstructions(dump.stream());
+			if (dump.enabled(DUMP_VARIABLES))
+				syn.printVariables(dump.stream());
 		}
 		else
 		{
 			throw runtime_error("\nException! Syntax analysis failed!\n");
 		}
 
-		LivenessAnalysis la(syn);
-		retVal = la.Do();
+		// Raspoređivanje pre alokacije (nad promenljivama)
+		if (options.schedule == SCHED_PRE)
+		{
+			TimeReport::Scope scope(report, "scheduling (pre)");
+			Scheduler scheduler(syn, false);
+			scheduler.schedule();
+			if (dump.enabled(DUMP_PASSES))
+				scheduler.printStatistics(dump.stream());
+		}
+
+		LivenessAnalysis la(syn, target, options.allocator);
+		{
+			TimeReport::Scope scope(report, "liveness and allocation");
+			retVal = la.Do();
+		}
 		if (retVal)
 		{
 			cout << "\nLiveness analysis and resource alocation finished successfully!" << endl;
-			la.printGraph();
-			la.printRegisters();
-			la.writeToFile(outputFile);
+			if (dump.enabled(DUMP_GRAPH))
+				la.printGraph(dump.stream());
+			if (dump.enabled(DUMP_REGISTERS))
+				la.printRegisters(dump.stream());
+
+			// Peephole optimizacije nad kodom sa dodeljenim registrima
+			Peephole peephole(syn);
+			{
+				TimeReport::Scope scope(report, "peephole");
+				peephole.Do();
+			}
+			if (dump.enabled(DUMP_PASSES))
+				peephole.printStatistics(dump.stream());
+
+			// Raspoređivanje nakon alokacije i popunjavanje delay slotova (poslednja izmena koda)
+			if (options.schedule != SCHED_NONE)
+			{
+				Scheduler scheduler(syn, true);
+				{
+					TimeReport::Scope scope(report, "scheduling");
+					if (options.schedule == SCHED_POST)
+						scheduler.schedule();
+					scheduler.fillDelaySlots();
+				}
+				if (dump.enabled(DUMP_PASSES))
+					scheduler.printStatistics(dump.stream());
+			}
+
+			{
+				TimeReport::Scope scope(report, "emission");
+				la.writeToFile(outputFile, options.schedule != SCHED_NONE);
+			}
+
+			// Mašinski kod bez prolaska kroz asembler
+			if (!options.objectFile.empty())
+			{
+				TimeReport::Scope scope(report, "object file");
+				MipsEncoder encoder(options.schedule != SCHED_NONE);
+				ObjectCode code = encoder.encode(syn.getInstructions(), syn.getMem());
+				ElfWriter(code).write(options.objectFile);
+			}
+
+			// Izvršavanje generisanog koda
+			if (options.simulate)
+			{
+				Simulator simulator(syn, options.schedule != SCHED_NONE);
+				{
+					TimeReport::Scope scope(report, "simulation");
+					simulator.run(options.simulateSteps);
+				}
+				simulator.printStatistics();
+			}
 		}
 		else
 		{
 			throw runtime_error("\nException! Liveness analysis and resource alocation failed!\n");
 		}
+
+		// Izveštaj o trajanju faza
+		if (options.timeReport)
+			report.printTable(cout);
+		if (!options.timeJson.empty())
+			report.writeJson(options.timeJson);
+		if (!options.timeTrace.empty())
+			report.writeTrace(options.timeTrace);
 	}
 	catch (runtime_error e)
 	{